@@ -0,0 +1,318 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ai.h"
+
+static const int dx[4] = {0, 1, 0, -1};
+static const int dy[4] = {-1, 0, 1, 0};
+
+void init_ai(Ai *ai) {
+    memset(ai, 0, sizeof(*ai));
+    ai->last_tick = -2;
+}
+
+void free_ai(Ai *ai) {
+    free(ai->visited);
+    free(ai->cost);
+    free(ai->parent);
+    free(ai->serial);
+    free(ai->heap);
+    free(ai->path);
+    ai->visited = NULL;
+    ai->cost = NULL;
+    ai->parent = NULL;
+    ai->serial = NULL;
+    ai->heap = NULL;
+    ai->path = NULL;
+    ai->size = 0;
+}
+
+// Tableaux par case alloués à la première décision et à chaque changement de taille
+static bool reserve_ai(Ai *ai, int size) {
+    if (ai->size == size) return true;
+
+    free_ai(ai);
+    size_t cells = (size_t)size * size;
+    ai->visited = calloc(cells, sizeof(uint32_t));
+    ai->cost = malloc(cells * sizeof(uint32_t));
+    ai->parent = malloc(cells);
+    ai->serial = malloc(cells * sizeof(uint32_t));
+    ai->path = malloc(cells);
+    ai->heap_capacity = 4 * AI_SEARCH_LIMIT + 4;
+    ai->heap = malloc(ai->heap_capacity * sizeof(AiNode));
+
+    if (!ai->visited || !ai->cost || !ai->parent || !ai->serial || !ai->path || !ai->heap) {
+        printf("Erreur: memoire insuffisante pour l'IA (map %dx%d)\n", size, size);
+        free_ai(ai);
+        return false;
+    }
+    ai->size = size;
+    ai->generation = 0;
+    ai->last_tick = -2;
+    ai->path_length = 0;
+    return true;
+}
+
+// Nouvelle génération : les marques des recherches précédentes deviennent caduques
+static uint32_t next_generation(Ai *ai) {
+    if (++ai->generation == 0) {
+        memset(ai->visited, 0, (size_t)ai->size * ai->size * sizeof(uint32_t));
+        ai->generation = 1;
+    }
+    return ai->generation;
+}
+
+// Voisine d'une case, avec la même téléportation aux bords que move_snake
+static int neighbor(const GameMap *map, int cell, int direction) {
+    int x = cell % map->size + dx[direction];
+    int y = cell / map->size + dy[direction];
+    if (x < 0) x = map->size - 1;
+    if (x >= map->size) x = 0;
+    if (y < 0) y = map->size - 1;
+    if (y >= map->size) y = 0;
+    return cell_index(map, x, y);
+}
+
+// Rang de chaque case du corps : un seul tampon par tick quand la partie avance
+// d'un pas depuis la décision précédente, sinon relecture complète du serpent
+static void sync_body(Ai *ai, Game *game) {
+    Snake *snake = &game->snake;
+    GameMap *map = &game->map;
+
+    if (game->ticks == ai->last_tick + 1) {
+        Point head = snake_head(snake);
+        ai->serial[cell_index(map, head.x, head.y)] = ++ai->pushes;
+    } else {
+        int slot = snake->tail;
+        ai->pushes = 0;
+        for (int i = 0; i < snake->length; i++) {
+            Point p = snake->body[slot];
+            ai->serial[cell_index(map, p.x, p.y)] = ++ai->pushes;
+            if (++slot == snake->capacity) slot = 0;
+        }
+        ai->path_length = 0;
+    }
+    ai->last_tick = game->ticks;
+}
+
+// La case sera-t-elle libre quand la tête y arrivera, dans steps pas ?
+// Un segment à distance d de la tête quitte sa case après length - d pas.
+static bool passable(const Ai *ai, const GameMap *map, int length, int cell, uint32_t steps) {
+    char c = cell_at(map, cell);
+    if (c == 'W' || c == 'O') return false;
+    if (!body_at(map, cell)) return true;
+
+    uint32_t from_head = ai->pushes - ai->serial[cell];
+    return steps + from_head >= (uint32_t)length;
+}
+
+static void heap_push(Ai *ai, uint64_t key, int cell) {
+    if (ai->heap_count == ai->heap_capacity) return;
+
+    int i = ai->heap_count++;
+    while (i > 0) {
+        int up = (i - 1) / 2;
+        if (ai->heap[up].key <= key) break;
+        ai->heap[i] = ai->heap[up];
+        i = up;
+    }
+    ai->heap[i].key = key;
+    ai->heap[i].cell = cell;
+}
+
+static AiNode heap_pop(Ai *ai) {
+    AiNode top = ai->heap[0];
+    AiNode last = ai->heap[--ai->heap_count];
+    int i = 0;
+
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= ai->heap_count) break;
+        if (child + 1 < ai->heap_count && ai->heap[child + 1].key < ai->heap[child].key) child++;
+        if (last.key <= ai->heap[child].key) break;
+        ai->heap[i] = ai->heap[child];
+        i = child;
+    }
+    ai->heap[i] = last;
+    return top;
+}
+
+static uint32_t distance(const GameMap *map, int from, int to) {
+    return (uint32_t)(abs(from % map->size - to % map->size) + abs(from / map->size - to / map->size));
+}
+
+static uint64_t node_key(uint32_t f, uint32_t g) {
+    return ((uint64_t)f << 32) | (uint32_t)~g;
+}
+
+// A* de la tête vers target ; en cas de succès le chemin est rangé dans ai->path
+static bool search(Ai *ai, Game *game, int start, int target) {
+    GameMap *map = &game->map;
+    int length = game->snake.length;
+    uint32_t generation = next_generation(ai);
+    int expanded = 0;
+
+    ai->heap_count = 0;
+    ai->visited[start] = generation;
+    ai->cost[start] = 0;
+    heap_push(ai, node_key(distance(map, start, target), 0), start);
+
+    while (ai->heap_count > 0 && expanded < AI_SEARCH_LIMIT) {
+        AiNode node = heap_pop(ai);
+        int cell = node.cell;
+        uint32_t g = ai->cost[cell];
+
+        // Entrée périmée : la case a été atteinte depuis par un chemin plus court
+        if ((uint32_t)(node.key >> 32) != g + distance(map, cell, target)) continue;
+
+        if (cell == target) {
+            ai->path_length = (int)g;
+            for (int k = (int)g - 1; k >= 0; k--) {
+                int d = ai->parent[cell];
+                ai->path[k] = (unsigned char)d;
+                cell = neighbor(map, cell, (d + 2) % 4);
+            }
+            ai->path_next = 0;
+            ai->path_target = target;
+            return true;
+        }
+        expanded++;
+
+        for (int d = 0; d < 4; d++) {
+            int next = neighbor(map, cell, d);
+            if (ai->visited[next] == generation && ai->cost[next] <= g + 1) continue;
+            if (!passable(ai, map, length, next, g + 1)) continue;
+
+            ai->visited[next] = generation;
+            ai->cost[next] = g + 1;
+            ai->parent[next] = (unsigned char)d;
+            heap_push(ai, node_key(g + 1 + distance(map, next, target), g + 1), next);
+        }
+    }
+    return false;
+}
+
+// Nombre de cases atteignables depuis start (parcours en largeur borné à limit)
+static int reachable_cells(Ai *ai, Game *game, int start, int limit) {
+    GameMap *map = &game->map;
+    int length = game->snake.length;
+    uint32_t generation = next_generation(ai);
+    int head = 0;
+    int count = 0;
+
+    if (limit > ai->heap_capacity) limit = ai->heap_capacity;
+    ai->visited[start] = generation;
+    ai->cost[start] = 1;
+    ai->heap[count++].cell = start;
+
+    while (head < count && count < limit) {
+        int cell = ai->heap[head++].cell;
+        for (int d = 0; d < 4 && count < limit; d++) {
+            int next = neighbor(map, cell, d);
+            if (ai->visited[next] == generation) continue;
+            if (!passable(ai, map, length, next, ai->cost[cell] + 1)) continue;
+
+            ai->visited[next] = generation;
+            ai->cost[next] = ai->cost[cell] + 1;
+            ai->heap[count++].cell = next;
+        }
+    }
+    return count;
+}
+
+// Fruit spécial s'il reste assez de temps pour l'atteindre, sinon fruit normal
+static int choose_target(Game *game, int head) {
+    GameMap *map = &game->map;
+    if (map->special_fruit_timer > 0 && map->special_fruit.x >= 0) {
+        int special = cell_index(map, map->special_fruit.x, map->special_fruit.y);
+        if ((int)distance(map, head, special) < map->special_fruit_timer) {
+            return special;
+        }
+    }
+    if (map->fruit.x >= 0) {
+        return cell_index(map, map->fruit.x, map->fruit.y);
+    }
+    return -1;
+}
+
+static int follow_path(Ai *ai, const GameMap *map, int head) {
+    int d = ai->path[ai->path_next++];
+    ai->expected_head = neighbor(map, head, d);
+    return d;
+}
+
+static int decide(Ai *ai, Game *game) {
+    GameMap *map = &game->map;
+    Snake *snake = &game->snake;
+    if (!reserve_ai(ai, map->size)) return snake->direction;
+
+    sync_body(ai, game);
+    bool ate = game->score != ai->last_score;
+    ai->last_score = game->score;
+
+    Point head_point = snake_head(snake);
+    int head = cell_index(map, head_point.x, head_point.y);
+    int target = choose_target(game, head);
+
+    // Le chemin précédent reste valable tant qu'il est suivi vers la même case
+    // sans avoir mangé (le corps garde alors la même chronologie)
+    if (!ate && ai->path_next < ai->path_length && head == ai->expected_head &&
+        target == ai->path_target &&
+        passable(ai, map, snake->length, neighbor(map, head, ai->path[ai->path_next]), 1)) {
+        return follow_path(ai, map, head);
+    }
+    ai->path_length = 0;
+
+    if (target >= 0) {
+        ai->searches++;
+        int fruit = map->fruit.x >= 0 ? cell_index(map, map->fruit.x, map->fruit.y) : -1;
+        if (search(ai, game, head, target) ||
+            (target != fruit && fruit >= 0 && search(ai, game, head, fruit))) {
+            if (ai->path_length > 0) return follow_path(ai, map, head);
+        }
+    }
+
+    // Pas de chemin : la case sûre qui laisse le plus de place
+    int best = snake->direction;
+    int best_space = -1;
+    int limit = snake->length + 64;
+    if (limit > AI_SEARCH_LIMIT) limit = AI_SEARCH_LIMIT;
+    for (int d = 0; d < 4; d++) {
+        int next = neighbor(map, head, d);
+        if (!passable(ai, map, snake->length, next, 1)) continue;
+
+        int space = reachable_cells(ai, game, next, limit);
+        if (space > best_space) {
+            best = d;
+            best_space = space;
+        }
+    }
+    return best;
+}
+
+// Direction à donner à change_direction avant le prochain update_game
+int ai_decide(Ai *ai, Game *game) {
+    uint64_t start = profiler_now();
+    int direction = decide(ai, game);
+    uint64_t duration = profiler_now() - start;
+
+    histogram_add(&ai->latency, duration > UINT32_MAX ? UINT32_MAX : (uint32_t)duration);
+    ai->latency_total += duration;
+    if (duration > ai->latency_max) ai->latency_max = duration;
+    ai->decisions++;
+    return direction;
+}
+
+// Moyenne et maximum sur toute la partie ; les centiles ne portent que sur les
+// dernières décisions gardées par l'histogramme
+void ai_print_stats(const Ai *ai) {
+    if (ai->decisions == 0) return;
+    printf("IA: %ld decisions, %ld recherches A*, latence moyenne %.1f us, max %.1f us\n",
+           ai->decisions, ai->searches,
+           (double)ai->latency_total / ai->decisions / 1000.0, ai->latency_max / 1000.0);
+    printf("IA: latence des %d dernieres decisions : p50 %.1f us, p99 %.1f us, max %.1f us\n",
+           ai->latency.count,
+           histogram_percentile(&ai->latency, 50) / 1000.0,
+           histogram_percentile(&ai->latency, 99) / 1000.0,
+           histogram_max(&ai->latency) / 1000.0);
+}
@@ -0,0 +1,53 @@
+#ifndef AI_H
+#define AI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+#include "profiler.h"
+
+// Joueur automatique : chemin A* vers le fruit, en comptant comme libres les
+// cases du corps qui auront été quittées quand la tête y arrivera. Le chemin
+// trouvé est suivi sur les ticks suivants tant qu'il reste valable.
+
+#define AI_SEARCH_LIMIT 250000   // Cases développées au plus par recherche
+
+typedef struct AiNode {
+    uint64_t key;       // f en poids fort, puis g décroissant (les chemins longs d'abord à f égal)
+    int cell;
+} AiNode;
+
+typedef struct Ai {
+    int size;                   // Taille de map des tableaux ci-dessous (0 : non alloués)
+    uint32_t generation;        // Les cases visitées portent la génération de la recherche
+    uint32_t *visited;
+    uint32_t *cost;             // Pas depuis la tête
+    unsigned char *parent;      // Direction d'arrivée dans la case
+    uint32_t *serial;           // Rang d'entrée de la tête dans chaque case du corps
+    uint32_t pushes;            // Segments ajoutés en tête depuis la dernière synchronisation
+    long last_tick;
+    int last_score;
+
+    AiNode *heap;
+    int heap_count;
+    int heap_capacity;
+
+    unsigned char *path;        // Directions du chemin en cours
+    int path_length;
+    int path_next;
+    int path_target;            // Case visée par le chemin
+    int expected_head;          // Case où doit se trouver la tête si le chemin est suivi
+
+    Histogram latency;          // Durée des HISTOGRAM_WINDOW dernières décisions (ns)
+    uint64_t latency_total;     // Sur toutes les décisions (ns)
+    uint64_t latency_max;
+    long decisions;
+    long searches;              // Décisions qui ont demandé une recherche A*
+} Ai;
+
+void init_ai(Ai *ai);
+void free_ai(Ai *ai);
+int ai_decide(Ai *ai, Game *game);
+void ai_print_stats(const Ai *ai);
+
+#endif
@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "arena.h"
+
+bool arena_init(Arena *arena, size_t capacity) {
+    arena->used = 0;
+    arena->capacity = capacity;
+    arena->base = malloc(capacity + ARENA_ALIGN);
+    if (!arena->base) {
+        printf("Erreur: memoire insuffisante (%zu octets)\n", capacity);
+        arena->capacity = 0;
+        return false;
+    }
+    return true;
+}
+
+void arena_free(Arena *arena) {
+    free(arena->base);
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+}
+
+// Toute la zone redevient disponible ; le contenu précédent n'est pas effacé
+void arena_reset(Arena *arena) {
+    arena->used = 0;
+}
+
+// Place prise dans la zone par une allocation de size octets (alignement compris)
+size_t arena_size(size_t size) {
+    return (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+// NULL si la zone est pleine
+void *arena_alloc(Arena *arena, size_t size) {
+    // Le bloc du système n'est pas forcément aligné : on aligne l'adresse, pas l'offset
+    uintptr_t start = ((uintptr_t)arena->base + arena->used + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1);
+    size_t offset = start - (uintptr_t)arena->base;
+    if (!arena->base || offset + size > arena->capacity + ARENA_ALIGN) {
+        return NULL;
+    }
+    arena->used = offset + arena_size(size);
+    return (void *)start;
+}
@@ -0,0 +1,25 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Allocateur par zone : un seul bloc réservé d'avance, découpé par simple
+// avancée d'un pointeur. Les allocations ne se libèrent pas une à une :
+// arena_reset rend toute la zone d'un coup, arena_free rend le bloc au système.
+
+#define ARENA_ALIGN 64   // Chaque allocation commence sur une ligne de cache
+
+typedef struct Arena {
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+} Arena;
+
+bool arena_init(Arena *arena, size_t capacity);
+void arena_free(Arena *arena);
+void arena_reset(Arena *arena);
+void *arena_alloc(Arena *arena, size_t size);
+size_t arena_size(size_t size);
+
+#endif
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "batch.h"
+
+static void observe_game(Batch *batch, int index) {
+    Game *game = &batch->games[index];
+    batch->directions[index] = game->snake.direction;
+    batch->heads[index] = snake_head(&game->snake);
+    batch->lengths[index] = game->snake.length;
+    batch->scores[index] = game->score;
+    batch->alive[index] = game->running;
+}
+
+bool create_batch(Batch *batch, int count, int size, int difficulty, uint64_t seed) {
+    size_t observed = arena_size(count * sizeof(Point)) + 3 * arena_size(count * sizeof(int)) +
+                      arena_size(count * sizeof(bool));
+
+    batch->count = count;
+    batch->size = size;
+    batch->difficulty = difficulty;
+    if (!arena_init(&batch->arena, arena_size(count * sizeof(Game)) + observed +
+                                   count * game_arena_size(size))) {
+        printf("Erreur: memoire insuffisante pour %d parties %dx%d\n", count, size, size);
+        batch->count = 0;
+        return false;
+    }
+    batch->games = arena_alloc(&batch->arena, count * sizeof(Game));
+    batch->directions = arena_alloc(&batch->arena, count * sizeof(int));
+    batch->heads = arena_alloc(&batch->arena, count * sizeof(Point));
+    batch->lengths = arena_alloc(&batch->arena, count * sizeof(int));
+    batch->scores = arena_alloc(&batch->arena, count * sizeof(int));
+    batch->alive = arena_alloc(&batch->arena, count * sizeof(bool));
+
+    for (int i = 0; i < count; i++) {
+        Game *game = &batch->games[i];
+
+        // La zone du lot porte la mémoire : celle de la partie reste vide
+        game->arena = (Arena){0};
+        game->input = (InputQueue){0};
+        game->map = create_map(&batch->arena, size);
+        game->snake = create_snake(&batch->arena, size / 2, size / 2, size * size);
+        game->difficulty = difficulty;
+        game->game_speed = 0;
+
+        seed_game(game, seed + i);
+        reset_game(game);
+        observe_game(batch, i);
+    }
+
+    return true;
+}
+
+void free_batch(Batch *batch) {
+    arena_free(&batch->arena);
+    batch->count = 0;
+}
+
+void reset_batch_game(Batch *batch, int index) {
+    Game *game = &batch->games[index];
+    seed_game(game, next_game_seed(game));
+    reset_game(game);
+    observe_game(batch, index);
+}
+
+// Avance d'un tick toutes les parties en cours. actions[i] est la direction
+// demandée pour la partie i (-1 pour la garder), actions peut être NULL.
+// Les parties terminées restent figées jusqu'à reset_batch_game.
+// Retourne le nombre de parties avancées.
+int step_batch(Batch *batch, const int *actions) {
+    int stepped = 0;
+
+    for (int i = 0; i < batch->count; i++) {
+        if (!batch->alive[i]) continue;
+
+        Game *game = &batch->games[i];
+        game->snake.direction = batch->directions[i];
+        if (actions && actions[i] >= 0) {
+            change_direction(&game->snake, actions[i]);
+        }
+        update_game(game);
+
+        batch->directions[i] = game->snake.direction;
+        batch->heads[i] = snake_head(&game->snake);
+        batch->lengths[i] = game->snake.length;
+        batch->scores[i] = game->score;
+        batch->alive[i] = game->running;
+        stepped++;
+    }
+
+    return stepped;
+}
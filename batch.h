@@ -0,0 +1,34 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "game.h"
+
+// Moteur de simulation par lots : N parties indépendantes de même taille.
+// Les tableaux de chaque partie (plans de bits, compteurs de cases libres,
+// corps des serpents) sont découpés dans une seule zone partagée par le lot,
+// et l'état de chaque partie vu par les joueurs (direction, tête, longueur,
+// score, vie) est rangé en structure de tableaux (SoA) dans la même zone.
+// La partie i démarre avec la graine seed + i ; chaque relance tire la graine
+// suivante dans le flux de la partie, ce qui garde le lot reproductible.
+typedef struct Batch {
+    int count;
+    int size;
+    int difficulty;
+    Arena arena;            // Toute la mémoire du lot, rendue en une fois par free_batch
+    Game *games;            // En-têtes des parties, pointant dans la zone
+
+    // État par partie, mis à jour par step_batch. directions fait foi entre deux
+    // pas : step_batch y applique actions[] puis le recopie dans la partie
+    int *directions;
+    Point *heads;
+    int *lengths;
+    int *scores;
+    bool *alive;
+} Batch;
+
+bool create_batch(Batch *batch, int count, int size, int difficulty, uint64_t seed);
+void free_batch(Batch *batch);
+void reset_batch_game(Batch *batch, int index);
+int step_batch(Batch *batch, const int *actions);
+
+#endif
@@ -0,0 +1,331 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "game.h"
+#include "framebuffer.h"
+
+// Micro-benchmarks de la logique du jeu et du rendu (make bench).
+// Chaque mesure donne le temps et le nombre d'allocations par opération,
+// en CSV (par défaut) ou en JSON (--json), pour comparer deux commits.
+
+#define VIEW_SIZE 600   // Taille de la fenêtre du jeu (WINDOW_SIZE), rendu hors écran
+
+// Comptage des allocations : l'édition de liens redirige malloc, calloc et
+// realloc vers les fonctions ci-dessous (-Wl,--wrap=..., voir le Makefile)
+static long alloc_count = 0;
+static size_t alloc_bytes = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    alloc_count++;
+    alloc_bytes += size;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    alloc_count++;
+    alloc_bytes += count * size;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    alloc_count++;
+    alloc_bytes += size;
+    return __real_realloc(ptr, size);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// État partagé par les mesures, préparé avant chaque série
+typedef struct Context {
+    Game game;
+    unsigned char *cycle;   // Direction à suivre depuis chaque case (circuit fermé)
+    Framebuffer fb;
+    Viewport viewport;
+    Arena arena;            // Zone réutilisée par create_map
+} Context;
+
+typedef void (*BenchFn)(Context *ctx, long iterations);
+
+static double min_time = 0.2;
+static bool json = false;
+static int results = 0;
+static volatile int sink;
+
+static void report(const char *name, long param, long iterations, double elapsed, long allocs, size_t bytes) {
+    double ns = elapsed * 1e9 / iterations;
+    double allocs_per_op = (double)allocs / iterations;
+    double bytes_per_op = (double)bytes / iterations;
+
+    if (json) {
+        printf("%s  {\"benchmark\": \"%s\", \"param\": %ld, \"iterations\": %ld, "
+               "\"ns_per_op\": %.2f, \"allocs_per_op\": %.3f, \"bytes_per_op\": %.1f}",
+               results > 0 ? ",\n" : "", name, param, iterations, ns, allocs_per_op, bytes_per_op);
+    } else {
+        printf("%s,%ld,%ld,%.2f,%.3f,%.1f\n", name, param, iterations, ns, allocs_per_op, bytes_per_op);
+    }
+    fflush(stdout);
+    results++;
+}
+
+// Double le nombre d'itérations jusqu'à dépasser min_time, puis publie la dernière mesure
+static void measure(const char *name, long param, BenchFn run, Context *ctx) {
+    long iterations = 1;
+    run(ctx, 1);   // Chauffe
+
+    for (;;) {
+        long allocs = alloc_count;
+        size_t bytes = alloc_bytes;
+        double start = now_seconds();
+        run(ctx, iterations);
+        double elapsed = now_seconds() - start;
+
+        if (elapsed >= min_time || iterations >= (1L << 32)) {
+            report(name, param, iterations, elapsed, alloc_count - allocs, alloc_bytes - bytes);
+            return;
+        }
+
+        double factor = elapsed > 0 ? 1.2 * min_time / elapsed : 100;
+        if (factor < 2) factor = 2;
+        if (factor > 100) factor = 100;
+        iterations = (long)(iterations * factor);
+    }
+}
+
+// Circuit hamiltonien de l'intérieur de la map (côté pair) : lignes en serpentin
+// de la colonne 2 à size-2, retour vers le haut par la colonne 1
+static unsigned char cycle_direction(int x, int y, int size) {
+    int n = size - 2;
+    x -= 1;
+    y -= 1;
+
+    if (x == 0) return y == 0 ? 1 : 0;
+    if (y % 2 == 0) return x < n - 1 ? 1 : 2;
+    if (x > 1) return 3;
+    return y == n - 1 ? 3 : 2;
+}
+
+// Map vide (murs seulement) juste assez grande pour un serpent de length cases
+// posé sur le circuit, sans fruit : move_snake ne fait qu'avancer
+static bool prepare_snake(Context *ctx, int length) {
+    int n = 2;
+    while (n * n < length + 2) n += 2;
+    int size = n + 2 < 8 ? 8 : n + 2;
+
+    if (!init_game(&ctx->game, size, 1, 1)) return false;
+    GameMap *map = &ctx->game.map;
+    reset_map(map);
+
+    ctx->cycle = malloc((size_t)size * size);
+    for (int y = 1; y < size - 1; y++) {
+        for (int x = 1; x < size - 1; x++) {
+            ctx->cycle[cell_index(map, x, y)] = cycle_direction(x, y, size);
+        }
+    }
+
+    static const int dx[4] = {0, 1, 0, -1};
+    static const int dy[4] = {-1, 0, 1, 0};
+    Snake *snake = &ctx->game.snake;
+    snake->head = snake->capacity - 1;
+    snake->tail = 0;
+    snake->length = 0;
+
+    Point p = {1, 1};
+    for (int i = 0; i < length; i++) {
+        add_segment(snake, p.x, p.y);
+        set_body_at(map, cell_index(map, p.x, p.y), true);
+        int d = ctx->cycle[cell_index(map, p.x, p.y)];
+        p.x += dx[d];
+        p.y += dy[d];
+    }
+    snake->direction = ctx->cycle[cell_index(map, snake_head(snake).x, snake_head(snake).y)];
+    return true;
+}
+
+static void release_snake(Context *ctx) {
+    free(ctx->cycle);
+    free_game(&ctx->game);
+}
+
+static void run_add_remove(Context *ctx, long iterations) {
+    Snake *snake = &ctx->game.snake;
+    for (long i = 0; i < iterations; i++) {
+        Point head = snake_head(snake);
+        add_segment(snake, head.x, head.y);
+        remove_tail(snake);
+    }
+}
+
+static void run_move(Context *ctx, long iterations) {
+    Game *game = &ctx->game;
+    for (long i = 0; i < iterations; i++) {
+        Point head = snake_head(&game->snake);
+        game->snake.direction = ctx->cycle[cell_index(&game->map, head.x, head.y)];
+        move_snake(game);
+    }
+}
+
+static void run_collision(Context *ctx, long iterations) {
+    int hits = 0;
+    for (long i = 0; i < iterations; i++) {
+        hits += check_collision(&ctx->game);
+    }
+    sink = hits;
+}
+
+// Un fruit posé puis retiré : le coût est celui du tirage d'une case libre
+static void run_spawn_fruit(Context *ctx, long iterations) {
+    GameMap *map = &ctx->game.map;
+    for (long i = 0; i < iterations; i++) {
+        spawn_fruit(map, map->size);
+        set_cell(map, map->fruit.x, map->fruit.y, ' ');
+        if (map->special_fruit_timer > 0) {
+            set_cell(map, map->special_fruit.x, map->special_fruit.y, ' ');
+            map->special_fruit_timer = 0;
+        }
+    }
+}
+
+// Zone déjà réservée : create_map ne fait qu'avancer un pointeur et remplir la map
+static void run_create_map(Context *ctx, long iterations) {
+    int size = ctx->game.map.size;
+    for (long i = 0; i < iterations; i++) {
+        arena_reset(&ctx->arena);
+        create_map(&ctx->arena, size);
+    }
+}
+
+// Partie complète : une seule allocation et une seule libération par tour
+static void run_init_game(Context *ctx, long iterations) {
+    int size = ctx->game.map.size;
+    for (long i = 0; i < iterations; i++) {
+        Game game;
+        if (!init_game(&game, size, 1, 1)) return;
+        free_game(&game);
+    }
+}
+
+// Relance dans la zone de la partie déjà réservée (menu, touche M)
+static void run_restart_game(Context *ctx, long iterations) {
+    int size = ctx->game.map.size;
+    for (long i = 0; i < iterations; i++) {
+        restart_game(&ctx->game, size, 1, (uint64_t)i);
+    }
+}
+
+static void run_render(Context *ctx, long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        fb_render_game(&ctx->fb, &ctx->game, &ctx->viewport);
+    }
+}
+
+static void bench_snake(void) {
+    static const int lengths[] = {3, 100, 1000, 10000};
+    Context ctx;
+
+    for (int i = 0; i < 4; i++) {
+        if (!prepare_snake(&ctx, lengths[i])) return;
+        measure("add_segment+remove_tail", lengths[i], run_add_remove, &ctx);
+        measure("move_snake", lengths[i], run_move, &ctx);
+        measure("check_collision", lengths[i], run_collision, &ctx);
+        release_snake(&ctx);
+    }
+}
+
+// Une part ratio des cases libres est occupée par le corps avant les tirages
+static void bench_spawn_fruit(void) {
+    static const int ratios[] = {0, 25, 50, 75, 90, 99};
+    Context ctx;
+
+    for (int i = 0; i < 6; i++) {
+        if (!init_game(&ctx.game, 100, 1, 1)) return;
+        GameMap *map = &ctx.game.map;
+        reset_map(map);
+
+        Rng rng;
+        rng_seed(&rng, 42);
+        for (int index = 0; index < map->size * map->size; index++) {
+            if (cell_at(map, index) == ' ' && rng_range(&rng, 100) < ratios[i]) {
+                set_body_at(map, index, true);
+            }
+        }
+        measure("spawn_fruit", ratios[i], run_spawn_fruit, &ctx);
+        free_game(&ctx.game);
+    }
+}
+
+static void bench_create_map(void) {
+    static const int sizes[] = {20, 100, 1000, 4000};
+    Context ctx;
+
+    for (int i = 0; i < 4; i++) {
+        ctx.game.map.size = sizes[i];
+        if (!arena_init(&ctx.arena, map_arena_size(sizes[i]))) return;
+        measure("create_map", sizes[i], run_create_map, &ctx);
+        arena_free(&ctx.arena);
+        measure("init_game+free_game", sizes[i], run_init_game, &ctx);
+        if (!init_game(&ctx.game, sizes[i], 1, 1)) return;
+        measure("restart_game", sizes[i], run_restart_game, &ctx);
+        free_game(&ctx.game);
+    }
+}
+
+// Image complète de la fenêtre dans un framebuffer hors écran : rendu logiciel
+// (fb_render_game), pas le renderer SDL de render_game
+static void bench_render(void) {
+    static const int sizes[] = {20, 100, 1000, 10000};
+    Context ctx;
+
+    if (!create_framebuffer(&ctx.fb, VIEW_SIZE, VIEW_SIZE)) return;
+    for (int i = 0; i < 4; i++) {
+        if (!init_game(&ctx.game, sizes[i], 2, 1)) break;
+        memset(&ctx.viewport, 0, sizeof(ctx.viewport));
+        update_viewport(&ctx.viewport, &ctx.game.map, snake_head(&ctx.game.snake), VIEW_SIZE, VIEW_SIZE);
+        measure("fb_render_game", sizes[i], run_render, &ctx);
+        free_game(&ctx.game);
+    }
+    free_framebuffer(&ctx.fb);
+}
+
+static void usage(const char *name) {
+    printf("Usage: %s [--json] [--time secondes]\n", name);
+}
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            min_time = atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (json) {
+        printf("[\n");
+    } else {
+        printf("benchmark,param,iterations,ns_per_op,allocs_per_op,bytes_per_op\n");
+    }
+
+    bench_snake();
+    bench_spawn_fruit();
+    bench_create_map();
+    bench_render();
+
+    if (json) {
+        printf("\n]\n");
+    }
+    return 0;
+}
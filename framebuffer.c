@@ -0,0 +1,274 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "framebuffer.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FB_X86 1
+#endif
+
+const uint32_t cell_palette[COLOR_COUNT] = {
+    0xFF000000,   // Fond (noir)
+    0xFF646464,   // Murs (gris)
+    0xFF8B4513,   // Obstacles (marron)
+    0xFFFF0000,   // Fruit normal (rouge)
+    0xFFFFD700,   // Fruit spécial (or)
+    0xFF00FF00    // Serpent (vert)
+};
+
+// Place la caméra sur un axe : elle ne bouge que si la tête approche du bord
+// visible, et se recentre alors sur elle
+static int follow_axis(int camera, int head, int visible, int size) {
+    if (visible >= size) return 0;
+    
+    int margin = visible / 4;
+    if (head < camera + margin || head >= camera + visible - margin) {
+        camera = head - visible / 2;
+    }
+    if (camera < 0) camera = 0;
+    if (camera > size - visible) camera = size - visible;
+    return camera;
+}
+
+// Retourne true si la zone visible a changé (l'image doit être refaite)
+bool update_viewport(Viewport *viewport, GameMap *map, Point head, int width, int height) {
+    int side = width < height ? width : height;
+    int cell_size = side / map->size;
+    if (cell_size < MIN_CELL_SIZE) cell_size = MIN_CELL_SIZE;
+    
+    int columns = width / cell_size;
+    int rows = height / cell_size;
+    if (columns > map->size) columns = map->size;
+    if (rows > map->size) rows = map->size;
+    
+    int x = follow_axis(viewport->x, head.x, columns, map->size);
+    int y = follow_axis(viewport->y, head.y, rows, map->size);
+    
+    bool changed = x != viewport->x || y != viewport->y || columns != viewport->columns ||
+                   rows != viewport->rows || cell_size != viewport->cell_size;
+    viewport->x = x;
+    viewport->y = y;
+    viewport->columns = columns;
+    viewport->rows = rows;
+    viewport->cell_size = cell_size;
+    return changed;
+}
+
+// Fruit spécial visible - clignotant si proche de la fin
+bool special_fruit_visible(GameMap *map) {
+    return map->special_fruit_timer > 0 &&
+           (map->special_fruit_timer > 20 || map->special_fruit_timer % 4 < 2);
+}
+
+int cell_color(GameMap *map, int index) {
+    if (body_at(map, index)) return COLOR_SNAKE;
+    
+    switch (cell_at(map, index)) {
+        case 'W': return COLOR_WALL;
+        case 'O': return COLOR_OBSTACLE;
+        case 'F': return COLOR_FRUIT;
+        case 'S': return special_fruit_visible(map) ? COLOR_SPECIAL : COLOR_EMPTY;
+        default: return COLOR_EMPTY;
+    }
+}
+
+// Remplissage d'une suite de pixels, une variante par jeu d'instructions
+static void fill_span_scalar(uint32_t *dst, int count, uint32_t color) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = color;
+    }
+}
+
+#ifdef FB_X86
+__attribute__((target("sse2")))
+static void fill_span_sse2(uint32_t *dst, int count, uint32_t color) {
+    __m128i value = _mm_set1_epi32((int)color);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128((__m128i *)(dst + i), value);
+    }
+    for (; i < count; i++) {
+        dst[i] = color;
+    }
+}
+
+__attribute__((target("avx2")))
+static void fill_span_avx2(uint32_t *dst, int count, uint32_t color) {
+    __m256i value = _mm256_set1_epi32((int)color);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256((__m256i *)(dst + i), value);
+    }
+    for (; i < count; i++) {
+        dst[i] = color;
+    }
+}
+#endif
+
+typedef void (*FillSpan)(uint32_t *dst, int count, uint32_t color);
+
+static FillSpan fill_span = NULL;
+static const char *backend_name = "scalaire";
+
+// "auto" choisit le meilleur jeu d'instructions disponible sur ce processeur
+bool fb_select_backend(const char *name) {
+    bool automatic = strcmp(name, "auto") == 0;
+    
+#ifdef FB_X86
+    __builtin_cpu_init();
+    if ((automatic || strcmp(name, "avx2") == 0) && __builtin_cpu_supports("avx2")) {
+        fill_span = fill_span_avx2;
+        backend_name = "avx2";
+        return true;
+    }
+    if ((automatic || strcmp(name, "sse2") == 0) && __builtin_cpu_supports("sse2")) {
+        fill_span = fill_span_sse2;
+        backend_name = "sse2";
+        return true;
+    }
+#endif
+    
+    if (automatic || strcmp(name, "scalaire") == 0) {
+        fill_span = fill_span_scalar;
+        backend_name = "scalaire";
+        return true;
+    }
+    return false;
+}
+
+const char *fb_backend_name(void) {
+    return backend_name;
+}
+
+bool create_framebuffer(Framebuffer *fb, int width, int height) {
+    fb->width = width;
+    fb->height = height;
+    fb->pitch = width;
+    fb->pixels = malloc((size_t)width * height * sizeof(uint32_t));
+    if (!fb->pixels) {
+        printf("Erreur: memoire insuffisante pour une image %dx%d\n", width, height);
+        return false;
+    }
+    
+    if (!fill_span) fb_select_backend("auto");
+    fb_fill_rect(fb, 0, 0, width, height, cell_palette[COLOR_EMPTY]);
+    return true;
+}
+
+void free_framebuffer(Framebuffer *fb) {
+    free(fb->pixels);
+    fb->pixels = NULL;
+}
+
+void fb_fill_rect(Framebuffer *fb, int x, int y, int width, int height, uint32_t color) {
+    if (x < 0) { width += x; x = 0; }
+    if (y < 0) { height += y; y = 0; }
+    if (x + width > fb->width) width = fb->width - x;
+    if (y + height > fb->height) height = fb->height - y;
+    if (width <= 0 || height <= 0) return;
+    
+    if (!fill_span) fb_select_backend("auto");
+    for (int row = y; row < y + height; row++) {
+        fill_span(fb->pixels + (size_t)row * fb->pitch + x, width, color);
+    }
+}
+
+// Recopie la première ligne de pixels d'une rangée de cases sur les suivantes
+static void repeat_line(Framebuffer *fb, uint32_t *line, int columns, int cell_size) {
+    for (int k = 1; k < cell_size; k++) {
+        memcpy(line + (size_t)k * fb->pitch, line, (size_t)columns * cell_size * sizeof(uint32_t));
+    }
+}
+
+// Cases d'un mot de 64 qui ont la couleur color, avec les priorités de cell_color
+static uint64_t color_word(GameMap *map, int word, int color, bool special) {
+    uint64_t body = map->planes[PLANE_BODY][word];
+    uint64_t wall = map->planes[PLANE_WALL][word];
+    uint64_t obstacle = map->planes[PLANE_OBSTACLE][word];
+    uint64_t fruit = map->planes[PLANE_FRUIT][word];
+    uint64_t bonus = special ? map->planes[PLANE_SPECIAL][word] : 0;
+    
+    switch (color) {
+        case COLOR_SNAKE: return body;
+        case COLOR_WALL: return wall & ~body;
+        case COLOR_OBSTACLE: return obstacle & ~(body | wall);
+        case COLOR_FRUIT: return fruit & ~(body | wall | obstacle);
+        case COLOR_SPECIAL: return bonus & ~(body | wall | obstacle | fruit);
+        default: return ~(body | wall | obstacle | fruit | bonus);
+    }
+}
+
+// Fin (exclue, au plus to) de la suite de cases de couleur color qui commence
+// en from : 64 cases par mot des plans au lieu d'un cell_color par case
+static int run_end(GameMap *map, int from, int to, int color, bool special) {
+    int cell = from;
+    while (cell < to) {
+        int word = cell >> 6;
+        uint64_t other = ~color_word(map, word, color, special) >> (cell & 63);
+        if (other) {
+            cell += __builtin_ctzll(other);
+            break;
+        }
+        cell = (word + 1) << 6;
+    }
+    return cell < to ? cell : to;
+}
+
+// Même image que render_game : chaque ligne de cases visible est découpée en
+// suites de même couleur directement dans les plans de bits, chaque suite est
+// un seul remplissage, puis la ligne est recopiée sur les cell_size lignes de
+// pixels qu'elle occupe.
+void fb_render_game(Framebuffer *fb, Game *game, const Viewport *viewport) {
+    GameMap *map = &game->map;
+    int cell_size = viewport->cell_size;
+    int columns = viewport->columns;
+    int rows = viewport->rows;
+    bool special = special_fruit_visible(map);
+    
+    if (!fill_span) fb_select_backend("auto");
+    if (columns * cell_size > fb->width) columns = fb->width / cell_size;
+    if (rows * cell_size > fb->height) rows = fb->height / cell_size;
+    
+    for (int y = 0; y < rows; y++) {
+        uint32_t *line = fb->pixels + (size_t)y * cell_size * fb->pitch;
+        int row_start = cell_index(map, viewport->x, viewport->y + y);
+        int x = 0;
+        
+        while (x < columns) {
+            int color = cell_color(map, row_start + x);
+            int end = run_end(map, row_start + x, row_start + columns, color, special) - row_start;
+            fill_span(line + x * cell_size, (end - x) * cell_size, cell_palette[color]);
+            x = end;
+        }
+        repeat_line(fb, line, columns, cell_size);
+    }
+}
+
+// Même rendu à partir des couleurs déjà capturées (viewport->columns par ligne),
+// pour le thread d'affichage qui ne lit pas la map
+void fb_render_cells(Framebuffer *fb, const unsigned char *cells, const Viewport *viewport) {
+    int cell_size = viewport->cell_size;
+    int columns = viewport->columns;
+    int rows = viewport->rows;
+    
+    if (!fill_span) fb_select_backend("auto");
+    if (columns * cell_size > fb->width) columns = fb->width / cell_size;
+    if (rows * cell_size > fb->height) rows = fb->height / cell_size;
+    
+    for (int y = 0; y < rows; y++) {
+        uint32_t *line = fb->pixels + (size_t)y * cell_size * fb->pitch;
+        const unsigned char *row = cells + (size_t)y * viewport->columns;
+        int x = 0;
+        
+        while (x < columns) {
+            int run = 1;
+            while (x + run < columns && row[x + run] == row[x]) {
+                run++;
+            }
+            fill_span(line + x * cell_size, run * cell_size, cell_palette[row[x]]);
+            x += run;
+        }
+        repeat_line(fb, line, columns, cell_size);
+    }
+}
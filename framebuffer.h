@@ -0,0 +1,56 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdint.h>
+#include "game.h"
+
+// Rendu logiciel : la map est rastérisée dans un tableau de pixels ARGB8888
+// avec des remplissages vectoriels (AVX2 ou SSE2, sinon boucle scalaire).
+// Ne dépend pas de SDL ; la version SDL copie ce tableau dans une texture.
+
+// Couleurs des cases, dans l'ordre de dessin (partagées avec render_game)
+enum {
+    COLOR_EMPTY,
+    COLOR_WALL,
+    COLOR_OBSTACLE,
+    COLOR_FRUIT,
+    COLOR_SPECIAL,
+    COLOR_SNAKE,
+    COLOR_COUNT
+};
+
+extern const uint32_t cell_palette[COLOR_COUNT];
+
+// Partie visible de la map. Quand la map ne tient pas dans la fenêtre avec des
+// cases d'au moins MIN_CELL_SIZE pixels, la caméra suit la tête : le coût d'une
+// image dépend alors de la taille de la fenêtre et non de celle de la map.
+#define MIN_CELL_SIZE 8
+
+typedef struct Viewport {
+    int x;              // Première case visible
+    int y;
+    int columns;        // Nombre de cases visibles
+    int rows;
+    int cell_size;      // Pixels par case
+} Viewport;
+
+typedef struct Framebuffer {
+    uint32_t *pixels;
+    int width;
+    int height;
+    int pitch;          // Pixels par ligne
+} Framebuffer;
+
+bool update_viewport(Viewport *viewport, GameMap *map, Point head, int width, int height);
+bool special_fruit_visible(GameMap *map);
+int cell_color(GameMap *map, int index);
+
+bool create_framebuffer(Framebuffer *fb, int width, int height);
+void free_framebuffer(Framebuffer *fb);
+bool fb_select_backend(const char *name);
+const char *fb_backend_name(void);
+void fb_fill_rect(Framebuffer *fb, int x, int y, int width, int height, uint32_t color);
+void fb_render_game(Framebuffer *fb, Game *game, const Viewport *viewport);
+void fb_render_cells(Framebuffer *fb, const unsigned char *cells, const Viewport *viewport);
+
+#endif
@@ -1,115 +1,309 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <time.h>
 #include "game.h"
-#include "snake.h"
+
+// Générateur pseudo-aléatoire (xoshiro128**, initialisé par splitmix64)
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint32_t rotl32(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+void rng_seed(Rng *rng, uint64_t seed) {
+    uint64_t a = splitmix64(&seed);
+    uint64_t b = splitmix64(&seed);
+    rng->state[0] = (uint32_t)a;
+    rng->state[1] = (uint32_t)(a >> 32);
+    rng->state[2] = (uint32_t)b;
+    rng->state[3] = (uint32_t)(b >> 32);
+}
+
+uint32_t rng_next(Rng *rng) {
+    uint32_t *s = rng->state;
+    uint32_t result = rotl32(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+    
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl32(s[3], 11);
+    
+    return result;
+}
+
+uint64_t rng_next64(Rng *rng) {
+    uint64_t high = rng_next(rng);
+    return (high << 32) | rng_next(rng);
+}
+
+// Entier dans [0, n) par multiplication plutôt que modulo
+int rng_range(Rng *rng, int n) {
+    return (int)(((uint64_t)rng_next(rng) * (uint32_t)n) >> 32);
+}
 
 // Implémentation Snake
-Snake create_snake(int start_x, int start_y) {
+Snake create_snake(Arena *arena, int start_x, int start_y, int capacity) {
     Snake snake;
-    snake.head = NULL;
-    snake.tail = NULL;
-    snake.direction = 3;
-    snake.length = 0;
-    
-    add_segment(&snake, start_x, start_y);
-    add_segment(&snake, start_x - 1, start_y);
-    add_segment(&snake, start_x - 2, start_y);
+    snake.body = arena_alloc(arena, (size_t)capacity * sizeof(Point));
+    snake.capacity = capacity;
+    reset_snake(&snake, start_x, start_y);
     
     return snake;
 }
 
+// Remet le serpent dans son état initial sans réallouer son buffer
+void reset_snake(Snake *snake, int start_x, int start_y) {
+    snake->head = snake->capacity - 1;
+    snake->tail = 0;
+    snake->direction = 3;
+    snake->length = 0;
+    snake->self_collision = false;
+    
+    add_segment(snake, start_x, start_y);
+    add_segment(snake, start_x - 1, start_y);
+    add_segment(snake, start_x - 2, start_y);
+}
+
+Point snake_head(Snake *snake) {
+    return snake->body[snake->head];
+}
+
+// Ajoute un segment en tête : O(1), aucune allocation
 void add_segment(Snake *snake, int x, int y) {
-    Node *new_node = malloc(sizeof(Node));
-    new_node->position.x = x;
-    new_node->position.y = y;
-    new_node->next = NULL;
-    
-    if (snake->head == NULL) {
-        snake->head = new_node;
-        snake->tail = new_node;
-    } else {
-        new_node->next = snake->head;
-        snake->head = new_node;
-    }
+    if (snake->length == snake->capacity) return;
+    
+    snake->head++;
+    if (snake->head == snake->capacity) snake->head = 0;
+    snake->body[snake->head].x = x;
+    snake->body[snake->head].y = y;
     snake->length++;
 }
 
+// Retire le segment de queue : O(1)
 void remove_tail(Snake *snake) {
-    if (snake->head == NULL) return;
+    if (snake->length == 0) return;
     
-    if (snake->head == snake->tail) {
-        free(snake->head);
-        snake->head = NULL;
-        snake->tail = NULL;
-    } else {
-        Node *current = snake->head;
-        while (current->next != snake->tail) {
-            current = current->next;
-        }
-        free(snake->tail);
-        current->next = NULL;
-        snake->tail = current;
-    }
+    snake->tail++;
+    if (snake->tail == snake->capacity) snake->tail = 0;
     snake->length--;
 }
 
-void free_snake(Snake *snake) {
-    while (snake->head != NULL) {
-        remove_tail(snake);
+// Implémentation GameMap
+
+// Bits des cases libres d'un mot : aucun plan levé. Les bits au-delà de la
+// dernière case (fin du dernier mot) ne sont jamais libres.
+static uint64_t free_word(GameMap *map, int word) {
+    uint64_t used = 0;
+    for (int plane = 0; plane < PLANE_COUNT; plane++) {
+        used |= map->planes[plane][word];
+    }
+    uint64_t bits = ~used;
+    
+    int cells = map->size * map->size;
+    if (word == map->words - 1 && (cells & 63)) {
+        bits &= (1ULL << (cells & 63)) - 1;
     }
+    return bits;
 }
 
-// Implémentation GameMap
-GameMap create_map(int size) {
-    GameMap map;
-    map.size = size;
-    map.grid = malloc(size * sizeof(char*));
-    map.obstacles_count = 0;
-    map.special_fruit_timer = 0;
-    map.special_fruit.x = -1;
-    map.special_fruit.y = -1;
-    
-    for (int i = 0; i < size; i++) {
-        map.grid[i] = malloc(size * sizeof(char));
-        for (int j = 0; j < size; j++) {
-            map.grid[i][j] = ' ';
-        }
+static bool cell_free(GameMap *map, int index) {
+    int word = index >> 6;
+    uint64_t bit = 1ULL << (index & 63);
+    uint64_t used = 0;
+    for (int plane = 0; plane < PLANE_COUNT; plane++) {
+        used |= map->planes[plane][word];
     }
+    return !(used & bit);
+}
+
+// Tient à jour les compteurs de cases libres après modification d'une case :
+// O(log blocs) dans l'arbre de Fenwick (une seule itération jusqu'à 64x64 cases)
+static void update_free(GameMap *map, int index, bool was_free) {
+    bool free_now = cell_free(map, index);
+    if (free_now == was_free) return;
     
-    // Murs extérieurs
-    for (int i = 0; i < size; i++) {
-        map.grid[0][i] = 'W';
-        map.grid[size-1][i] = 'W';
-        map.grid[i][0] = 'W';
-        map.grid[i][size-1] = 'W';
+    int delta = free_now ? 1 : -1;
+    map->free_count += delta;
+    for (int i = (index >> FREE_BLOCK_SHIFT) + 1; i <= map->blocks; i += i & -i) {
+        map->free_blocks[i - 1] += delta;
     }
-    
-    map.fruit.x = -1;
-    map.fruit.y = -1;
+}
+
+// Nombre de mots de 64 bits d'un plan, et de blocs de cases libres
+int map_words(int size) {
+    return (int)(((size_t)size * size + 63) / 64);
+}
+
+int map_blocks(int size) {
+    return (int)(((size_t)size * size + (1 << FREE_BLOCK_SHIFT) - 1) >> FREE_BLOCK_SHIFT);
+}
+
+// Branche la map sur une mémoire fournie : PLANE_COUNT * map_words(size) mots
+// et map_blocks(size) compteurs (voir create_map)
+void attach_map(GameMap *map, int size, uint64_t *bits, int *free_blocks) {
+    map->size = size;
+    map->words = map_words(size);
+    for (int plane = 0; plane < PLANE_COUNT; plane++) {
+        map->planes[plane] = bits ? bits + (size_t)plane * map->words : NULL;
+    }
+    map->free_blocks = free_blocks;
+    map->blocks = map_blocks(size);
+}
+
+// Place prise dans une zone par create_map
+size_t map_arena_size(int size) {
+    return arena_size((size_t)PLANE_COUNT * map_words(size) * sizeof(uint64_t)) +
+           arena_size(map_blocks(size) * sizeof(int));
+}
+
+GameMap create_map(Arena *arena, int size) {
+    GameMap map;
+    attach_map(&map, size, arena_alloc(arena, (size_t)PLANE_COUNT * map_words(size) * sizeof(uint64_t)),
+               arena_alloc(arena, map_blocks(size) * sizeof(int)));
+    map.static_version = 0;
+    reset_map(&map);
     
     return map;
 }
 
-void free_map(GameMap *map) {
-    for (int i = 0; i < map->size; i++) {
-        free(map->grid[i]);
+// Vide la map (murs extérieurs seulement) sans réallouer ses tableaux
+void reset_map(GameMap *map) {
+    int size = map->size;
+    map->obstacles_count = 0;
+    map->special_fruit_timer = 0;
+    map->special_fruit.x = -1;
+    map->special_fruit.y = -1;
+    map->fruit.x = -1;
+    map->fruit.y = -1;
+    map->static_version++;
+    
+    memset(map->planes[0], 0, (size_t)PLANE_COUNT * map->words * sizeof(uint64_t));
+    
+    // Murs extérieurs
+    uint64_t *walls = map->planes[PLANE_WALL];
+    for (int i = 0; i < size; i++) {
+        int cells[4] = {
+            cell_index(map, i, 0), cell_index(map, i, size - 1),
+            cell_index(map, 0, i), cell_index(map, size - 1, i)
+        };
+        for (int k = 0; k < 4; k++) {
+            walls[cells[k] >> 6] |= 1ULL << (cells[k] & 63);
+        }
+    }
+    
+    // Cases libres comptées mot par mot, puis compteurs des blocs remontés en
+    // arbre de Fenwick en O(blocs)
+    memset(map->free_blocks, 0, map->blocks * sizeof(int));
+    map->free_count = 0;
+    for (int w = 0; w < map->words; w++) {
+        int count = __builtin_popcountll(free_word(map, w));
+        map->free_blocks[w >> (FREE_BLOCK_SHIFT - 6)] += count;
+        map->free_count += count;
+    }
+    for (int i = 1; i <= map->blocks; i++) {
+        int parent = i + (i & -i);
+        if (parent <= map->blocks) map->free_blocks[parent - 1] += map->free_blocks[i - 1];
     }
-    free(map->grid);
 }
 
 char get_cell(GameMap *map, int x, int y) {
     if (x < 0 || x >= map->size || y < 0 || y >= map->size) {
         return 'W';
     }
-    return map->grid[y][x];
+    return cell_at(map, cell_index(map, x, y));
 }
 
 void set_cell(GameMap *map, int x, int y, char value) {
     if (x >= 0 && x < map->size && y >= 0 && y < map->size) {
-        map->grid[y][x] = value;
+        set_cell_at(map, cell_index(map, x, y), value);
+    }
+}
+
+void set_cell_at(GameMap *map, int index, char value) {
+    char old = cell_at(map, index);
+    if (old == 'W' || old == 'O' || value == 'W' || value == 'O') {
+        map->static_version++;
+    }
+    
+    bool was_free = cell_free(map, index);
+    int word = index >> 6;
+    uint64_t bit = 1ULL << (index & 63);
+    for (int plane = PLANE_WALL; plane <= PLANE_SPECIAL; plane++) {
+        map->planes[plane][word] &= ~bit;
+    }
+    switch (value) {
+        case 'W': map->planes[PLANE_WALL][word] |= bit; break;
+        case 'O': map->planes[PLANE_OBSTACLE][word] |= bit; break;
+        case 'F': map->planes[PLANE_FRUIT][word] |= bit; break;
+        case 'S': map->planes[PLANE_SPECIAL][word] |= bit; break;
+        default: break;
+    }
+    update_free(map, index, was_free);
+}
+
+bool is_body(GameMap *map, int x, int y) {
+    if (x < 0 || x >= map->size || y < 0 || y >= map->size) {
+        return false;
+    }
+    return body_at(map, cell_index(map, x, y));
+}
+
+void set_body(GameMap *map, int x, int y, bool occupied) {
+    if (x >= 0 && x < map->size && y >= 0 && y < map->size) {
+        set_body_at(map, cell_index(map, x, y), occupied);
+    }
+}
+
+void set_body_at(GameMap *map, int index, bool occupied) {
+    bool was_free = cell_free(map, index);
+    uint64_t *word = &map->planes[PLANE_BODY][index >> 6];
+    uint64_t bit = 1ULL << (index & 63);
+    *word = occupied ? (*word | bit) : (*word & ~bit);
+    update_free(map, index, was_free);
+}
+
+// k-ième case libre (0 <= k < free_count) dans l'ordre des indices : descente
+// dans l'arbre de Fenwick jusqu'au bloc (O(log blocs)), puis par mots
+// (popcount, 64 au plus) et enfin dans le mot
+int find_free_cell(GameMap *map, int k) {
+    int block = 0;
+    for (int step = 1 << (31 - __builtin_clz(map->blocks)); step > 0; step >>= 1) {
+        int next = block + step;
+        if (next <= map->blocks && map->free_blocks[next - 1] <= k) {
+            block = next;
+            k -= map->free_blocks[next - 1];
+        }
+    }
+    
+    for (int w = block << (FREE_BLOCK_SHIFT - 6); w < map->words; w++) {
+        uint64_t bits = free_word(map, w);
+        int count = __builtin_popcountll(bits);
+        if (k < count) {
+            while (k-- > 0) bits &= bits - 1;   // Retire les k bits les plus bas
+            return (w << 6) + __builtin_ctzll(bits);
+        }
+        k -= count;
     }
+    return -1;
+}
+
+// Nombre de cases d'un plan (obstacles, murs, corps...)
+int count_cells(GameMap *map, int plane) {
+    int count = 0;
+    for (int w = 0; w < map->words; w++) {
+        count += __builtin_popcountll(map->planes[plane][w]);
+    }
+    return count;
 }
 
 void spawn_obstacles(GameMap *map, int size, int difficulty) {
@@ -127,108 +321,142 @@ void spawn_obstacles(GameMap *map, int size, int difficulty) {
     map->obstacles_count = 0;
     
     for (int i = 0; i < num_obstacles; i++) {
-        int x, y;
         bool valid_position = false;
         int attempts = 0;
         
-        while (!valid_position && attempts < 100) {
-            x = rand() % (size - 4) + 2;
-            y = rand() % (size - 4) + 2;
+        // Tirage parmi les cases libres ; on garde une marge de 2 cases avec les murs
+        while (!valid_position && attempts < 100 && map->free_count > 0) {
+            int index = find_free_cell(map, rng_range(&map->rng, map->free_count));
+            int x = index % size;
+            int y = index / size;
             
-            if (get_cell(map, x, y) == ' ') {
+            if (x >= 2 && x < size - 2 && y >= 2 && y < size - 2) {
                 valid_position = true;
-                set_cell(map, x, y, 'O');
-                map->obstacles_count++;
+                set_cell_at(map, index, 'O');
             }
             attempts++;
         }
     }
+    
+    map->obstacles_count = count_cells(map, PLANE_OBSTACLE);
 }
 
-void spawn_fruit(GameMap *map, int size) {
-    int x, y;
-    bool valid_position = false;
-    
-    while (!valid_position) {
-        x = rand() % (size - 2) + 1;
-        y = rand() % (size - 2) + 1;
-        
-        if (get_cell(map, x, y) == ' ') {
-            valid_position = true;
-            map->fruit.x = x;
-            map->fruit.y = y;
-            set_cell(map, x, y, 'F');
-        }
+// Retourne false si aucune case n'est libre (plateau rempli)
+bool spawn_fruit(GameMap *map, int size) {
+    if (map->free_count == 0) {
+        map->fruit.x = -1;
+        map->fruit.y = -1;
+        return false;
     }
     
+    int index = find_free_cell(map, rng_range(&map->rng, map->free_count));
+    map->fruit.x = index % size;
+    map->fruit.y = index / size;
+    set_cell_at(map, index, 'F');
+    
     // 20% de chance d'apparition d'un fruit spécial
-    if (rand() % 5 == 0 && map->special_fruit_timer <= 0) {
-        valid_position = false;
-        while (!valid_position) {
-            x = rand() % (size - 2) + 1;
-            y = rand() % (size - 2) + 1;
-            
-            if (get_cell(map, x, y) == ' ') {
-                valid_position = true;
-                map->special_fruit.x = x;
-                map->special_fruit.y = y;
-                map->special_fruit_timer = 100; // Durée d'apparition
-                set_cell(map, x, y, 'S');
-            }
-        }
+    if (rng_range(&map->rng, 5) == 0 && map->special_fruit_timer <= 0 && map->free_count > 0) {
+        index = find_free_cell(map, rng_range(&map->rng, map->free_count));
+        map->special_fruit.x = index % size;
+        map->special_fruit.y = index / size;
+        map->special_fruit_timer = 100; // Durée d'apparition
+        set_cell_at(map, index, 'S');
     }
+    
+    return true;
 }
 
 // GameLogic
-void init_game(Game *game, int size, int difficulty) {
-    game->map = create_map(size);
+
+// Taille de la zone d'une partie : plans de la map et anneau du serpent
+size_t game_arena_size(int size) {
+    return map_arena_size(size) + arena_size((size_t)size * size * sizeof(Point));
+}
+
+// Plus grande map dont la partie tient dans MAX_GAME_BYTES (environ 15800 cases de côté)
+int max_board_size(void) {
+    int low = 8;
+    int high = MAX_INDEX_SIZE;
+    while (low < high) {
+        int middle = low + (high - low + 1) / 2;
+        if (game_arena_size(middle) <= MAX_GAME_BYTES) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+
+// Une seule allocation pour toute la partie, rendue par free_game ; false si
+// elle échoue (rien à libérer)
+bool init_game(Game *game, int size, int difficulty, uint64_t seed) {
+    game->arena = (Arena){0};
+    game->input = (InputQueue){0};
+    return restart_game(game, size, difficulty, seed);
+}
+
+// Zone de la partie assez grande pour une map size x size ; rien n'est
+// alloué si la zone actuelle suffit
+bool reserve_game(Game *game, int size) {
+    size_t needed = game_arena_size(size);
+    if (game->arena.base && game->arena.capacity >= needed) return true;
+    arena_free(&game->arena);
+    return arena_init(&game->arena, needed);
+}
+
+// Nouvelle partie, éventuellement d'une autre taille, dans la zone existante :
+// les tableaux sont redécoupés depuis le début de la zone puis remplis.
+// false si la zone ne peut pas être agrandie (la partie n'est pas jouable)
+bool restart_game(Game *game, int size, int difficulty, uint64_t seed) {
+    if (!reserve_game(game, size)) {
+        return false;
+    }
+    arena_reset(&game->arena);
+    game->map = create_map(&game->arena, size);
+    game->snake = create_snake(&game->arena, size / 2, size / 2, size * size);
     game->difficulty = difficulty;
+    seed_game(game, seed);
+    reset_game(game);
+    return true;
+}
+
+// À appeler avant reset_game pour que la partie soit rejouable depuis cette graine
+void seed_game(Game *game, uint64_t seed) {
+    game->seed = seed;
+    rng_seed(&game->map.rng, seed);
+}
+
+// Graine de la partie suivante, tirée dans le flux de la partie courante
+uint64_t next_game_seed(Game *game) {
+    return rng_next64(&game->map.rng);
+}
+
+// Nouvelle partie avec la même taille et la même difficulté, sans allocation
+void reset_game(Game *game) {
+    int size = game->map.size;
+    reset_map(&game->map);
+    reset_snake(&game->snake, size / 2, size / 2);
     
-    int start_x = size / 2;
-    int start_y = size / 2;
-    game->snake = create_snake(start_x, start_y);
+    for (int i = 0; i < game->snake.length; i++) {
+        Point segment = game->snake.body[i];
+        set_body_at(&game->map, cell_index(&game->map, segment.x, segment.y), true);
+    }
+    input_clear(&game->input);
+    game->input_time = 0;
     game->running = true;
-    game->in_menu = false;
     game->score = 0;
+    game->ticks = 0;
+    game->won = false;
     
-    spawn_obstacles(&game->map, size, difficulty);
+    spawn_obstacles(&game->map, size, game->difficulty);
     spawn_fruit(&game->map, size);
-    
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        printf("Erreur SDL: %s\n", SDL_GetError());
-        exit(1);
-    }
-    
-    game->window = SDL_CreateWindow(
-        "Snake Game - Menu",
-        SDL_WINDOWPOS_CENTERED,
-        SDL_WINDOWPOS_CENTERED,
-        WINDOW_SIZE,
-        WINDOW_SIZE,
-        SDL_WINDOW_SHOWN
-    );
-    
-    if (!game->window) {
-        printf("Erreur fenêtre: %s\n", SDL_GetError());
-        SDL_Quit();
-        exit(1);
-    }
-    
-    game->renderer = SDL_CreateRenderer(game->window, -1, SDL_RENDERER_ACCELERATED);
-    if (!game->renderer) {
-        printf("Erreur renderer: %s\n", SDL_GetError());
-        SDL_DestroyWindow(game->window);
-        SDL_Quit();
-        exit(1);
-    }
 }
 
 void free_game(Game *game) {
-    free_snake(&game->snake);
-    free_map(&game->map);
-    SDL_DestroyRenderer(game->renderer);
-    SDL_DestroyWindow(game->window);
-    SDL_Quit();
+    arena_free(&game->arena);
+    game->snake.body = NULL;
+    game->snake.length = 0;
 }
 
 void change_direction(Snake *snake, int new_direction) {
@@ -241,7 +469,7 @@ void change_direction(Snake *snake, int new_direction) {
 }
 
 void move_snake(Game *game) {
-    Point new_head = game->snake.head->position;
+    Point new_head = snake_head(&game->snake);
     
     switch (game->snake.direction) {
         case 0: new_head.y--; break;
@@ -256,21 +484,40 @@ void move_snake(Game *game) {
     if (new_head.y < 0) new_head.y = game->map.size - 1;
     if (new_head.y >= game->map.size) new_head.y = 0;
     
-    add_segment(&game->snake, new_head.x, new_head.y);
+    Snake *snake = &game->snake;
+    GameMap *map = &game->map;
+    bool ate = false;
     
-    char cell = get_cell(&game->map, new_head.x, new_head.y);
+    // Après la téléportation la tête est toujours dans la grille : accès direct
+    int head_index = cell_index(map, new_head.x, new_head.y);
+    char cell = cell_at(map, head_index);
     if (cell == 'F') {
         game->score += 10;
-        spawn_fruit(&game->map, game->map.size);
+        set_cell_at(map, head_index, ' ');
+        ate = true;
     } else if (cell == 'S') {
         game->score += 30;
-        game->map.special_fruit.x = -1;
-        game->map.special_fruit.y = -1;
-        game->map.special_fruit_timer = 0;
-        set_cell(&game->map, new_head.x, new_head.y, ' ');
-        spawn_fruit(&game->map, game->map.size);
+        map->special_fruit.x = -1;
+        map->special_fruit.y = -1;
+        map->special_fruit_timer = 0;
+        set_cell_at(map, head_index, ' ');
+        // Le fruit normal est replacé : on efface l'ancien de la grille
+        set_cell(map, map->fruit.x, map->fruit.y, ' ');
+        ate = true;
     } else {
-        remove_tail(&game->snake);
+        // La queue libère sa case avant que la tête n'avance
+        Point tail = snake->body[snake->tail];
+        set_body_at(map, cell_index(map, tail.x, tail.y), false);
+        remove_tail(snake);
+    }
+    
+    snake->self_collision = body_at(map, head_index);
+    add_segment(snake, new_head.x, new_head.y);
+    set_body_at(map, head_index, true);
+    
+    // Plus aucune case libre pour un fruit : le serpent remplit le plateau
+    if (ate && !spawn_fruit(map, map->size)) {
+        game->won = true;
     }
     
     // Mettre à jour le timer du fruit spécial
@@ -285,30 +532,45 @@ void move_snake(Game *game) {
 }
 
 bool check_collision(Game *game) {
-    Point head = game->snake.head->position;
+    Snake *snake = &game->snake;
+    Point head = snake_head(snake);
     
     // Collision avec murs ou obstacles
-    char cell = get_cell(&game->map, head.x, head.y);
+    char cell = cell_at(&game->map, cell_index(&game->map, head.x, head.y));
     if (cell == 'W' || cell == 'O') {
         return true;
     }
     
-    // Collision avec soi-même
-    Node *current = game->snake.head->next;
-    while (current != NULL) {
-        if (current->position.x == head.x && current->position.y == head.y) {
-            return true;
-        }
-        current = current->next;
+    // Collision avec soi-même : une seule lecture de la grille d'occupation
+    if (snake->self_collision) {
+        return true;
     }
     
     return false;
 }
 
+// Une commande de la file par tick, pour qu'un second appui rapide ne puisse pas
+// faire demi-tour avant que le premier ait déplacé la tête. Les commandes sans
+// effet (demi-tour, direction courante) sont sautées.
+static void apply_input(Game *game) {
+    InputCommand command;
+    game->input_time = 0;
+    while (input_pop(&game->input, &command)) {
+        int before = game->snake.direction;
+        change_direction(&game->snake, command.direction);
+        if (game->snake.direction != before) {
+            game->input_time = command.time;
+            return;
+        }
+    }
+}
+
 void update_game(Game *game) {
+    apply_input(game);
+    game->ticks++;
     move_snake(game);
     
-    if (check_collision(game)) {
+    if (check_collision(game) || game->won) {
         game->running = false;
     }
 }
\ No newline at end of file
@@ -1,10 +1,131 @@
 #ifndef GAME_H
 #define GAME_H
 
-#include "snake.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "arena.h"
+#include "input.h"
+
+// Logique du jeu pure : aucune dépendance à SDL (utilisée par snake et snake_headless)
+
+#define MAX_OBSTACLES 20
+
+// Structures
+
+// Générateur pseudo-aléatoire propre à chaque partie (xoshiro128**) :
+// rapide, sans verrou, et une partie se rejoue à l'identique depuis sa graine
+typedef struct Rng {
+    uint32_t state[4];
+} Rng;
+
+typedef struct Point {
+    int x;
+    int y;
+} Point;
+
+// Corps du serpent : buffer circulaire de capacité fixe (map.size * map.size),
+// pris une seule fois dans la zone de la partie par create_snake. head et tail sont des indices dans body.
+typedef struct Snake {
+    Point *body;
+    int capacity;
+    int head;
+    int tail;
+    int direction;
+    int length;
+    bool self_collision;  // La tête vient d'entrer dans une case du corps
+} Snake;
+
+// Contenu des cases en plans de bits : un bit par case et par type de contenu,
+// soit 5 bits par case au lieu d'un char et d'un octet d'occupation.
+// Une case est libre quand aucun de ses bits n'est levé.
+enum {
+    PLANE_WALL,
+    PLANE_OBSTACLE,
+    PLANE_FRUIT,
+    PLANE_SPECIAL,
+    PLANE_BODY,
+    PLANE_COUNT
+};
+
+#define FREE_BLOCK_SHIFT 12   // Cases libres comptées par blocs de 4096 cases (64 mots)
+
+typedef struct GameMap {
+    uint64_t *planes[PLANE_COUNT];  // words mots de 64 bits par plan, bit i = case i
+    int words;
+    int *free_blocks;     // Arbre de Fenwick des cases libres par bloc, pour trouver la k-ième case libre
+    int blocks;
+    int free_count;       // Cases ni mur, ni obstacle, ni fruit, ni serpent
+    int size;
+    Point fruit;
+    Point special_fruit;
+    int obstacles_count;
+    int special_fruit_timer;
+    Rng rng;              // Tirages des obstacles et des fruits
+    
+    // Suivi des changements pour l'affichage (voir render_game)
+    unsigned int static_version;          // Incrémenté quand un mur ou un obstacle change
+} GameMap;
+
+// Mémoire maximale d'une partie (plans de la map et anneau du serpent de size * size
+// cases) ; la taille de map correspondante est donnée par max_board_size
+#define MAX_GAME_BYTES ((size_t)2 << 30)
+#define MAX_INDEX_SIZE 46340    // size * size doit tenir dans un int
+
+typedef struct Game {
+    Snake snake;
+    GameMap map;
+    Arena arena;          // Toute la mémoire de la partie (map et serpent), un seul bloc
+    bool running;
+    int score;
+    long ticks;           // Nombre d'appels à update_game depuis le début de la partie
+    bool won;             // Plateau rempli par le serpent
+    int difficulty;
+    int game_speed;
+    int board_size;       // Taille imposée par --size, 0 : selon la difficulté
+    uint64_t seed;        // Graine de la partie en cours
+    InputQueue input;     // Directions demandées, une appliquée par update_game
+    uint64_t input_time;  // Instant de l'appui appliqué au dernier tick (0 : aucun)
+} Game;
+
+// Indice d'une case dans les tableaux plats de la map (sans contrôle de bornes)
+static inline int cell_index(const GameMap *map, int x, int y) {
+    return y * map->size + x;
+}
+
+static inline bool plane_test(const GameMap *map, int plane, int index) {
+    return (map->planes[plane][index >> 6] >> (index & 63)) & 1;
+}
+
+// Contenu d'une case sous forme de caractère ('W', 'O', 'F', 'S' ou ' ')
+static inline char cell_at(const GameMap *map, int index) {
+    int word = index >> 6;
+    uint64_t bit = 1ULL << (index & 63);
+    if (map->planes[PLANE_WALL][word] & bit) return 'W';
+    if (map->planes[PLANE_OBSTACLE][word] & bit) return 'O';
+    if (map->planes[PLANE_FRUIT][word] & bit) return 'F';
+    if (map->planes[PLANE_SPECIAL][word] & bit) return 'S';
+    return ' ';
+}
+
+static inline bool body_at(const GameMap *map, int index) {
+    return plane_test(map, PLANE_BODY, index);
+}
+
+// Prototypes pour le générateur pseudo-aléatoire
+void rng_seed(Rng *rng, uint64_t seed);
+uint32_t rng_next(Rng *rng);
+uint64_t rng_next64(Rng *rng);
+int rng_range(Rng *rng, int n);
 
 // Prototypes pour la logique du jeu
-void init_game(Game *game, int size, int difficulty);
+size_t game_arena_size(int size);
+int max_board_size(void);
+bool init_game(Game *game, int size, int difficulty, uint64_t seed);
+bool reserve_game(Game *game, int size);
+bool restart_game(Game *game, int size, int difficulty, uint64_t seed);
+void seed_game(Game *game, uint64_t seed);
+uint64_t next_game_seed(Game *game);
+void reset_game(Game *game);
 void free_game(Game *game);
 void change_direction(Snake *snake, int new_direction);
 void move_snake(Game *game);
@@ -12,17 +133,28 @@ bool check_collision(Game *game);
 void update_game(Game *game);
 
 // Prototypes pour le module Snake
-Snake create_snake(int start_x, int start_y);
+Snake create_snake(Arena *arena, int start_x, int start_y, int capacity);
+void reset_snake(Snake *snake, int start_x, int start_y);
+Point snake_head(Snake *snake);
 void add_segment(Snake *snake, int x, int y);
 void remove_tail(Snake *snake);
-void free_snake(Snake *snake);
 
 // Prototypes pour le module GameMap
-GameMap create_map(int size);
-void free_map(GameMap *map);
+int map_words(int size);
+int map_blocks(int size);
+void attach_map(GameMap *map, int size, uint64_t *bits, int *free_blocks);
+size_t map_arena_size(int size);
+GameMap create_map(Arena *arena, int size);
+void reset_map(GameMap *map);
 char get_cell(GameMap *map, int x, int y);
 void set_cell(GameMap *map, int x, int y, char value);
+void set_cell_at(GameMap *map, int index, char value);
+bool is_body(GameMap *map, int x, int y);
+void set_body(GameMap *map, int x, int y, bool occupied);
+void set_body_at(GameMap *map, int index, bool occupied);
+int find_free_cell(GameMap *map, int k);
+int count_cells(GameMap *map, int plane);
 void spawn_obstacles(GameMap *map, int size, int difficulty);
-void spawn_fruit(GameMap *map, int size);
+bool spawn_fruit(GameMap *map, int size);
 
-#endif
\ No newline at end of file
+#endif
@@ -1,225 +1,556 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include "graphics.h"
 #include "game.h"
-#include "snake.h"
+#include "framebuffer.h"
 
-void handle_events(Game *game) {
+// software : rendu logiciel (framebuffer) au lieu du renderer accéléré.
+// Il est aussi choisi automatiquement si le renderer accéléré n'est pas disponible.
+bool init_display(Display *display, bool software) {
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        printf("Erreur SDL: %s\n", SDL_GetError());
+        return false;
+    }
+    
+    display->window = SDL_CreateWindow(
+        "Snake Game - Menu",
+        SDL_WINDOWPOS_CENTERED,
+        SDL_WINDOWPOS_CENTERED,
+        WINDOW_SIZE,
+        WINDOW_SIZE,
+        SDL_WINDOW_SHOWN
+    );
+    
+    if (!display->window) {
+        printf("Erreur fenêtre: %s\n", SDL_GetError());
+        SDL_Quit();
+        return false;
+    }
+    
+    display->renderer = NULL;
+    if (!software) {
+        display->renderer = SDL_CreateRenderer(display->window, -1, SDL_RENDERER_ACCELERATED);
+        if (!display->renderer) {
+            printf("Renderer accelere indisponible (%s), rendu logiciel\n", SDL_GetError());
+            software = true;
+        }
+    }
+    if (software) {
+        display->renderer = SDL_CreateRenderer(display->window, -1, SDL_RENDERER_SOFTWARE);
+    }
+    if (!display->renderer) {
+        printf("Erreur renderer: %s\n", SDL_GetError());
+        SDL_DestroyWindow(display->window);
+        SDL_Quit();
+        return false;
+    }
+    
+    // Rendu logiciel : l'image est rastérisée dans fb puis copiée dans fb_texture
+    display->software = software;
+    display->fb.pixels = NULL;
+    display->fb_texture = NULL;
+    if (software) {
+        display->fb_texture = SDL_CreateTexture(display->renderer, SDL_PIXELFORMAT_ARGB8888,
+                                                SDL_TEXTUREACCESS_STREAMING, WINDOW_SIZE, WINDOW_SIZE);
+        if (!display->fb_texture || !create_framebuffer(&display->fb, WINDOW_SIZE, WINDOW_SIZE)) {
+            printf("Erreur rendu logiciel: %s\n", SDL_GetError());
+            SDL_DestroyRenderer(display->renderer);
+            SDL_DestroyWindow(display->window);
+            SDL_Quit();
+            return false;
+        }
+        printf("Rendu logiciel (%s)\n", fb_backend_name());
+    }
+    
+    // Textures de cache seulement si le renderer sait dessiner dans une texture
+    display->static_layer = NULL;
+    display->frame = NULL;
+    if (!software && SDL_RenderTargetSupported(display->renderer)) {
+        display->static_layer = SDL_CreateTexture(display->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                                  SDL_TEXTUREACCESS_TARGET, WINDOW_SIZE, WINDOW_SIZE);
+        display->frame = SDL_CreateTexture(display->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                           SDL_TEXTUREACCESS_TARGET, WINDOW_SIZE, WINDOW_SIZE);
+        if (!display->static_layer || !display->frame) {
+            if (display->static_layer) SDL_DestroyTexture(display->static_layer);
+            if (display->frame) SDL_DestroyTexture(display->frame);
+            display->static_layer = NULL;
+            display->frame = NULL;
+        }
+    }
+    display->rects = NULL;
+    display->rects_capacity = 0;
+    int visible = (WINDOW_SIZE / MIN_CELL_SIZE) * (WINDOW_SIZE / MIN_CELL_SIZE);
+    display->drawn = malloc(visible);
+    display->dirty = malloc(visible * sizeof(int));
+    display->simulation = NULL;
+    if (!display->drawn || !display->dirty) {
+        printf("Erreur: memoire insuffisante pour l'affichage\n");
+        free_display(display);
+        return false;
+    }
+    display->autopilot = false;
+    display->scenes.scene = SCENE_MENU;
+    display->menu = (Menu){0, -1};
+    invalidate_display(display);
+    
+    return true;
+}
+
+// À appeler quand une nouvelle partie commence : tout le cache est à refaire
+void invalidate_display(Display *display) {
+    display->cache_valid = false;
+}
+
+void free_display(Display *display) {
+    if (display->fb_texture) SDL_DestroyTexture(display->fb_texture);
+    free_framebuffer(&display->fb);
+    if (display->static_layer) SDL_DestroyTexture(display->static_layer);
+    if (display->frame) SDL_DestroyTexture(display->frame);
+    free(display->rects);
+    free(display->drawn);
+    free(display->dirty);
+    SDL_DestroyRenderer(display->renderer);
+    SDL_DestroyWindow(display->window);
+    SDL_Quit();
+}
+
+static const char *scene_titles[] = {
+    "Snake Game - Menu",
+    "Snake Game - En cours",
+    "Snake Game - Pause",
+    "Snake Game - Perdu (ESPACE: rejouer, M: menu)",
+    "Snake Game"
+};
+
+// Crochets des scènes : hors de la scène de jeu, le thread de simulation est
+// arrêté et Game appartient au thread d'affichage
+static void scene_stop(void *context) {
+    Display *display = context;
+    stop_simulation(display->simulation);
+}
+
+static void scene_resume(void *context) {
+    Display *display = context;
+    resume_simulation(display->simulation);
+}
+
+static void scene_entered(void *context, Scene scene) {
+    Display *display = context;
+    if (scene == SCENE_MENU) {
+        display->menu = (Menu){0, -1};
+    }
+    if (scene != SCENE_QUIT) {
+        SDL_SetWindowTitle(display->window, scene_titles[scene]);
+    }
+}
+
+static void scene_restarted(void *context) {
+    invalidate_display(context);
+}
+
+void attach_scenes(Display *display, Game *game, Simulation *simulation) {
+    SceneHooks hooks = {scene_stop, scene_resume, scene_entered, scene_restarted, display};
+    display->simulation = simulation;
+    init_scenes(&display->scenes, game, hooks);
+}
+
+// Instant d'un événement SDL (ms depuis SDL_Init) sur l'horloge de profiler_now
+static uint64_t event_time(Uint32 timestamp) {
+    Uint32 age = SDL_GetTicks() - timestamp;
+    return profiler_now() - (uint64_t)age * 1000000;
+}
+
+// Touches de la partie (scènes jeu, pause et fin de partie)
+static void game_key(Display *display, Game *game, const SDL_KeyboardEvent *key) {
+    Scenes *scenes = &display->scenes;
+    bool steer = scenes->scene == SCENE_PLAYING && !display->autopilot;
+    
+    // Les flèches passent par la file de la partie : update_game en applique une
+    // par tick. Avec l'IA (--ai), elles ne dirigent plus le serpent.
+    switch (key->keysym.sym) {
+        case SDLK_UP:
+            if (steer) input_push(&game->input, 0, event_time(key->timestamp));
+            break;
+        case SDLK_RIGHT:
+            if (steer) input_push(&game->input, 1, event_time(key->timestamp));
+            break;
+        case SDLK_DOWN:
+            if (steer) input_push(&game->input, 2, event_time(key->timestamp));
+            break;
+        case SDLK_LEFT:
+            if (steer) input_push(&game->input, 3, event_time(key->timestamp));
+            break;
+        case SDLK_p:
+            scene_toggle_pause(scenes);
+            break;
+        case SDLK_SPACE:
+        case SDLK_RETURN:
+            scene_replay(scenes);
+            break;
+        case SDLK_ESCAPE:
+            set_scene(scenes, SCENE_QUIT);
+            break;
+        case SDLK_F3:
+            // Le panneau recouvre une partie de l'image : tout est à redessiner
+            display->profiler.overlay = !display->profiler.overlay;
+            invalidate_display(display);
+            break;
+        case SDLK_m:
+            scene_back_to_menu(scenes);
+            break;
+    }
+}
+
+// Retourne true si au moins un événement a été traité (l'écran peut avoir changé)
+bool handle_events(Display *display, Game *game) {
     SDL_Event event;
-    while (SDL_PollEvent(&event)) {
+    bool handled = false;
+    while (display->scenes.scene != SCENE_QUIT && SDL_PollEvent(&event)) {
+        if (display->scenes.scene == SCENE_MENU) {
+            // Le menu n'est redessiné que si sa sélection change
+            MenuState state = menu_event(&display->menu, &event, &handled);
+            if (state == MENU_START) {
+                scene_start_game(&display->scenes, display->menu.selected);
+            } else if (state == MENU_QUIT) {
+                set_scene(&display->scenes, SCENE_QUIT);
+            }
+            continue;
+        }
+        handled = true;
         if (event.type == SDL_QUIT) {
-            game->running = false;
+            set_scene(&display->scenes, SCENE_QUIT);
         } else if (event.type == SDL_KEYDOWN) {
-            switch (event.key.keysym.sym) {
-                case SDLK_UP:
-                    change_direction(&game->snake, 0);
-                    break;
-                case SDLK_RIGHT:
-                    change_direction(&game->snake, 1);
-                    break;
-                case SDLK_DOWN:
-                    change_direction(&game->snake, 2);
-                    break;
-                case SDLK_LEFT:
-                    change_direction(&game->snake, 3);
-                    break;
-                case SDLK_ESCAPE:
-                    game->running = false;
-                    break;
-                case SDLK_m:
-                    game->in_menu = true;
-                    show_menu(game);
-                    break;
-            }
+            game_key(display, game, &event.key);
         }
     }
+    return handled;
 }
 
-void render_menu(Game *game, int selected_option) {
-    SDL_SetRenderDrawColor(game->renderer, 0, 0, 0, 255);
-    SDL_RenderClear(game->renderer);
-    
-    SDL_Color white = {255, 255, 255, 255};
-    SDL_Color yellow = {255, 255, 0, 255};
-    
-    char *options[] = {
-        "FACILE - Petite map, peu d'obstacles",
-        "MOYEN - Map moyenne, obstacles modérés", 
-        "DIFFICILE - Grande map, nombreux obstacles"
-    };
+static const char *menu_options[MENU_OPTIONS] = {
+    "FACILE - Petite map, peu d'obstacles",
+    "MOYEN - Map moyenne, obstacles modérés", 
+    "DIFFICILE - Grande map, nombreux obstacles"
+};
+
+// Menu console : curseur ramené en haut et écran effacé par séquences ANSI,
+// sans lancer de shell
+static void print_menu(int selected_option) {
+    printf("\033[H\033[2J");
+    printf("=== SNAKE GAME - MENU ===\n\n");
+    printf("Utilisez les fleches ↑↓ pour naviguer\n");
+    printf("ESPACE pour selectionner\n\n");
     
-    // Afficher les instructions dans la console
-    if (selected_option != -1) {
-        system("clear");  // Effacer la console (Linux)
-        printf("=== SNAKE GAME - MENU ===\n\n");
-        printf("Utilisez les fleches ↑↓ pour naviguer\n");
-        printf("ESPACE pour selectionner\n\n");
-        
-        for (int i = 0; i < 3; i++) {
-            if (i == selected_option) {
-                printf(">>> %s <<<\n", options[i]);
-            } else {
-                printf("    %s\n", options[i]);
-            }
+    for (int i = 0; i < MENU_OPTIONS; i++) {
+        if (i == selected_option) {
+            printf(">>> %s <<<\n", menu_options[i]);
+        } else {
+            printf("    %s\n", menu_options[i]);
         }
-        printf("\n[ESPACE] Commencer | [ECHAP] Quitter\n");
     }
+    printf("\n[ESPACE] Commencer | [ECHAP] Quitter\n");
+    fflush(stdout);
+}
+
+void render_menu(Display *display, int selected_option) {
+    SDL_SetRenderDrawColor(display->renderer, 0, 0, 0, 255);
+    SDL_RenderClear(display->renderer);
+    
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color yellow = {255, 255, 0, 255};
     
     // Dessiner des formes simples pour le menu visuel
-    for (int i = 0; i < 3; i++) {
+    for (int i = 0; i < MENU_OPTIONS; i++) {
         SDL_Color color = (i == selected_option) ? yellow : white;
-        SDL_SetRenderDrawColor(game->renderer, color.r, color.g, color.b, color.a);
+        SDL_SetRenderDrawColor(display->renderer, color.r, color.g, color.b, color.a);
         
         // Cadre de l'option
         SDL_Rect option_rect = {100, 200 + i * 80, 400, 60};
-        SDL_RenderDrawRect(game->renderer, &option_rect);
+        SDL_RenderDrawRect(display->renderer, &option_rect);
         
         // Cercle de sélection
         if (i == selected_option) {
             SDL_Rect selector = {70, 215 + i * 80, 20, 20};
-            SDL_RenderFillRect(game->renderer, &selector);
+            SDL_RenderFillRect(display->renderer, &selector);
         }
         
         // Texte simplifié (juste des barres pour représenter le texte)
-        SDL_SetRenderDrawColor(game->renderer, color.r, color.g, color.b, color.a);
+        SDL_SetRenderDrawColor(display->renderer, color.r, color.g, color.b, color.a);
         for (int j = 0; j < 5; j++) {
             SDL_Rect text_bar = {120, 225 + i * 80 + j * 6, 200 + j * 10, 3};
-            SDL_RenderFillRect(game->renderer, &text_bar);
+            SDL_RenderFillRect(display->renderer, &text_bar);
         }
     }
     
     // Instructions en bas
-    SDL_SetRenderDrawColor(game->renderer, 100, 100, 255, 255);
+    SDL_SetRenderDrawColor(display->renderer, 100, 100, 255, 255);
     for (int j = 0; j < 3; j++) {
         SDL_Rect instr_bar = {150, 500 + j * 10, 300 - j * 20, 4};
-        SDL_RenderFillRect(game->renderer, &instr_bar);
-    }
-    
-    SDL_RenderPresent(game->renderer);
-}
-
-void show_menu(Game *game) {
-    int selected_option = 0;
-    bool menu_running = true;
-    
-    while (menu_running && game->running) {
-        SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                game->running = false;
-                menu_running = false;
-            } else if (event.type == SDL_KEYDOWN) {
-                switch (event.key.keysym.sym) {
-                    case SDLK_UP:
-                        selected_option = (selected_option - 1 + 3) % 3;
-                        break;
-                    case SDLK_DOWN:
-                        selected_option = (selected_option + 1) % 3;
-                        break;
-                    case SDLK_SPACE:
-                    case SDLK_RETURN:
-                        menu_running = false;
-                        // Définir la taille et la vitesse selon la difficulté
-                        int size;
-                        switch (selected_option) {
-                            case 0: 
-                                size = 15; 
-                                game->game_speed = 200; // Facile = lent
-                                break;
-                            case 1: 
-                                size = 20; 
-                                game->game_speed = 150; // Moyen = normal
-                                break;
-                            case 2: 
-                                size = 25; 
-                                game->game_speed = 100; // Difficile = rapide
-                                break;
-                            default: 
-                                size = 20; 
-                                game->game_speed = 150;
-                                break;
-                        }
-                        init_game(game, size, selected_option + 1);
-                        SDL_SetWindowTitle(game->window, "Snake Game - En cours");
-                        break;
-                    case SDLK_ESCAPE:
-                        game->running = false;
-                        menu_running = false;
-                        break;
+        SDL_RenderFillRect(display->renderer, &instr_bar);
+    }
+    
+    SDL_RenderPresent(display->renderer);
+}
+
+// Transition du menu pour un événement ; redraw passe à true si l'image doit
+// être refaite (sélection changée ou fenêtre à repeindre)
+MenuState menu_event(Menu *menu, const SDL_Event *event, bool *redraw) {
+    if (event->type == SDL_QUIT) {
+        return MENU_QUIT;
+    }
+    if (event->type == SDL_WINDOWEVENT && event->window.event == SDL_WINDOWEVENT_EXPOSED) {
+        *redraw = true;
+    } else if (event->type == SDL_KEYDOWN) {
+        switch (event->key.keysym.sym) {
+            case SDLK_UP:
+                menu->selected = (menu->selected - 1 + MENU_OPTIONS) % MENU_OPTIONS;
+                *redraw = true;
+                break;
+            case SDLK_DOWN:
+                menu->selected = (menu->selected + 1) % MENU_OPTIONS;
+                *redraw = true;
+                break;
+            case SDLK_SPACE:
+            case SDLK_RETURN:
+                return MENU_START;
+            case SDLK_ESCAPE:
+                return MENU_QUIT;
+        }
+    }
+    return MENU_OPEN;
+}
+
+// Affiche le menu ; la console n'est réécrite que si la sélection a changé
+void draw_menu(Display *display, Menu *menu) {
+    if (menu->printed != menu->selected) {
+        print_menu(menu->selected);
+        menu->printed = menu->selected;
+    }
+    render_menu(display, menu->selected);
+}
+
+#define STACK_RECTS 256   // Taille des lots quand le tableau de rectangles ne peut pas grandir
+
+// Tableau de rectangles pour count cases à la fois. Si l'agrandissement échoue,
+// l'ancien tableau est gardé et l'appelant envoie des lots de STACK_RECTS depuis la pile
+static bool reserve_rects(Display *display, int count) {
+    if (count <= display->rects_capacity) return true;
+    
+    SDL_Rect *rects = realloc(display->rects, count * sizeof(SDL_Rect));
+    if (!rects) return false;
+    display->rects = rects;
+    display->rects_capacity = count;
+    return true;
+}
+
+// Rectangle à l'écran de la case visible numéro index (ligne par ligne)
+static SDL_Rect cell_rect(const Viewport *viewport, int index) {
+    SDL_Rect rect = {
+        index % viewport->columns * viewport->cell_size,
+        index / viewport->columns * viewport->cell_size,
+        viewport->cell_size, viewport->cell_size
+    };
+    return rect;
+}
+
+static void fill_rects(Display *display, int color, const SDL_Rect *rects, int count) {
+    if (count == 0) return;
+    uint32_t c = cell_palette[color];
+    SDL_SetRenderDrawColor(display->renderer, (c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF, c >> 24);
+    SDL_RenderFillRects(display->renderer, rects, count);
+}
+
+// Envoie les cases visibles dont la couleur est dans [first, last], un lot par couleur
+static void draw_visible_cells(Display *display, const Snapshot *snapshot, int first, int last) {
+    int visible = snapshot->viewport.columns * snapshot->viewport.rows;
+    SDL_Rect stack_rects[STACK_RECTS];
+    SDL_Rect *rects = stack_rects;
+    int capacity = STACK_RECTS;
+    if (reserve_rects(display, visible)) {
+        rects = display->rects;
+        capacity = visible;
+    }
+    
+    for (int color = first; color <= last; color++) {
+        int count = 0;
+        for (int i = 0; i < visible; i++) {
+            if (snapshot->cells[i] == color) {
+                if (count == capacity) {
+                    fill_rects(display, color, rects, count);
+                    count = 0;
                 }
+                rects[count++] = cell_rect(&snapshot->viewport, i);
             }
         }
-        
-        render_menu(game, selected_option);
-        SDL_Delay(16);
+        fill_rects(display, color, rects, count);
     }
 }
 
-void render_game(Game *game) {
-    int cell_size = WINDOW_SIZE / game->map.size;
+// Image complète : couche statique (murs et obstacles) puis fruits et serpent
+static void draw_full(Display *display, const Snapshot *snapshot, bool static_changed) {
+    if (display->static_layer) {
+        if (static_changed) {
+            SDL_SetRenderTarget(display->renderer, display->static_layer);
+            SDL_SetRenderDrawColor(display->renderer, 0, 0, 0, 255);
+            SDL_RenderClear(display->renderer);
+            draw_visible_cells(display, snapshot, COLOR_WALL, COLOR_OBSTACLE);
+            display->static_version = snapshot->static_version;
+        }
+        SDL_SetRenderTarget(display->renderer, display->frame);
+        SDL_RenderCopy(display->renderer, display->static_layer, NULL, NULL);
+    } else {
+        SDL_SetRenderDrawColor(display->renderer, 0, 0, 0, 255);
+        SDL_RenderClear(display->renderer);
+        draw_visible_cells(display, snapshot, COLOR_WALL, COLOR_OBSTACLE);
+    }
     
-    SDL_SetRenderDrawColor(game->renderer, 0, 0, 0, 255);
-    SDL_RenderClear(game->renderer);
+    draw_visible_cells(display, snapshot, COLOR_FRUIT, COLOR_SNAKE);
+}
+
+// Mise à jour partielle de l'image : seules les cases qui ont changé de couleur
+// depuis la dernière image dessinée
+static void draw_dirty(Display *display, const Snapshot *snapshot) {
+    int visible = snapshot->viewport.columns * snapshot->viewport.rows;
+    int count = 0;
+    SDL_Rect stack_rects[STACK_RECTS];
+    SDL_Rect *rects = stack_rects;
+    int capacity = STACK_RECTS;
+    if (reserve_rects(display, visible)) {
+        rects = display->rects;
+        capacity = visible;
+    }
     
-    // Murs (gris)
-    SDL_SetRenderDrawColor(game->renderer, 100, 100, 100, 255);
-    for (int y = 0; y < game->map.size; y++) {
-        for (int x = 0; x < game->map.size; x++) {
-            char cell = get_cell(&game->map, x, y);
-            if (cell == 'W') {
-                SDL_Rect wall = {x * cell_size, y * cell_size, cell_size, cell_size};
-                SDL_RenderFillRect(game->renderer, &wall);
-            }
+    for (int i = 0; i < visible; i++) {
+        if (snapshot->cells[i] != display->drawn[i]) {
+            display->dirty[count++] = i;
         }
     }
     
-    // Obstacles (marron)
-    SDL_SetRenderDrawColor(game->renderer, 139, 69, 19, 255);
-    for (int y = 0; y < game->map.size; y++) {
-        for (int x = 0; x < game->map.size; x++) {
-            char cell = get_cell(&game->map, x, y);
-            if (cell == 'O') {
-                SDL_Rect obstacle = {x * cell_size, y * cell_size, cell_size, cell_size};
-                SDL_RenderFillRect(game->renderer, &obstacle);
+    SDL_SetRenderTarget(display->renderer, display->frame);
+    for (int color = 0; color < COLOR_COUNT; color++) {
+        int batch = 0;
+        for (int i = 0; i < count; i++) {
+            if (snapshot->cells[display->dirty[i]] == color) {
+                if (batch == capacity) {
+                    fill_rects(display, color, rects, batch);
+                    batch = 0;
+                }
+                rects[batch++] = cell_rect(&snapshot->viewport, display->dirty[i]);
             }
         }
+        fill_rects(display, color, rects, batch);
+    }
+}
+
+// Rectangle opaque par-dessus l'image, quel que soit le mode de rendu
+static void overlay_rect(Display *display, int x, int y, int w, int h, uint32_t color) {
+    if (display->software) {
+        fb_fill_rect(&display->fb, x, y, w, h, color);
+    } else {
+        SDL_Rect rect = {x, y, w, h};
+        SDL_SetRenderDrawColor(display->renderer, (color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF, 255);
+        SDL_RenderFillRect(display->renderer, &rect);
     }
+}
+
+// Panneau du profileur (pas de police disponible) : une ligne par phase dans l'ordre
+// de l'énumération, avec trois barres p50 (vert), p99 (jaune) et max (rouge).
+// Échelle logarithmique de 1 us à la durée d'un tick, un trait gris par décade.
+#define OVERLAY_WIDTH 200
+#define OVERLAY_BAR 4
+
+static int overlay_length(uint32_t ns, double budget_ns) {
+    if (ns <= 1000) return ns > 0 ? 1 : 0;
+    int length = (int)(OVERLAY_WIDTH * log10(ns / 1000.0) / log10(budget_ns / 1000.0));
+    if (length < 1) length = 1;
+    return length < OVERLAY_WIDTH ? length : OVERLAY_WIDTH;
+}
+
+// Les ticks sont mesurés par le thread de simulation : leurs valeurs viennent de l'image
+static void draw_profiler_overlay(Display *display, const Snapshot *snapshot) {
+    static const uint32_t colors[3] = {0xFF00C000, 0xFFE0E000, 0xFFE00000};
+    Profiler *profiler = &display->profiler;
+    double budget_ns = snapshot->game_speed > 0 ? snapshot->game_speed * 1e6 : 1e8;
+    int row = 3 * OVERLAY_BAR + 4;
     
-    // Fruit normal (rouge)
-    SDL_SetRenderDrawColor(game->renderer, 255, 0, 0, 255);
-    SDL_Rect fruit_rect = {
-        game->map.fruit.x * cell_size,
-        game->map.fruit.y * cell_size,
-        cell_size, cell_size
-    };
-    SDL_RenderFillRect(game->renderer, &fruit_rect);
-    
-    // Fruit spécial (or) - clignotant si proche de la fin
-    if (game->map.special_fruit_timer > 0) {
-        if (game->map.special_fruit_timer > 20 || game->map.special_fruit_timer % 4 < 2) {
-            SDL_SetRenderDrawColor(game->renderer, 255, 215, 0, 255);
-            SDL_Rect special_rect = {
-                game->map.special_fruit.x * cell_size,
-                game->map.special_fruit.y * cell_size,
-                cell_size, cell_size
-            };
-            SDL_RenderFillRect(game->renderer, &special_rect);
-        }
-    }
-    
-    // Serpent (vert)
-    SDL_SetRenderDrawColor(game->renderer, 0, 255, 0, 255);
-    Node *current = game->snake.head;
-    while (current != NULL) {
-        SDL_Rect segment = {
-            current->position.x * cell_size,
-            current->position.y * cell_size,
-            cell_size, cell_size
+    overlay_rect(display, 0, 0, OVERLAY_WIDTH + 8, PHASE_COUNT * row + 4, 0xFF202020);
+    for (double decade = 1e4; decade < budget_ns; decade *= 10) {
+        overlay_rect(display, 4 + overlay_length((uint32_t)decade, budget_ns), 2, 1,
+                     PHASE_COUNT * row, 0xFF606060);
+    }
+    
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        Histogram *histogram = &profiler->phases[p];
+        uint32_t values[3] = {
+            histogram_percentile(histogram, 50),
+            histogram_percentile(histogram, 99),
+            histogram_max(histogram)
         };
-        SDL_RenderFillRect(game->renderer, &segment);
-        current = current->next;
+        if (p == PHASE_UPDATE) {
+            memcpy(values, snapshot->update_ns, sizeof(values));
+        }
+        for (int k = 0; k < 3; k++) {
+            int length = overlay_length(values[k], budget_ns);
+            if (length > 0) {
+                overlay_rect(display, 4, 4 + p * row + k * OVERLAY_BAR, length, OVERLAY_BAR - 1, colors[k]);
+            }
+        }
     }
+}
+
+void render_game(Display *display, const Snapshot *snapshot) {
+    // La caméra (choisie par la simulation) a bougé : toute l'image est refaite
+    const Viewport *viewport = &snapshot->viewport;
+    bool moved = memcmp(&display->viewport, viewport, sizeof(Viewport)) != 0;
+    int visible = viewport->columns * viewport->rows;
+    display->viewport = *viewport;
+    
+    Profiler *profiler = &display->profiler;
+    uint64_t start = profiler_now();
+    
+    if (display->software) {
+        if (!display->cache_valid || moved) {
+            fb_fill_rect(&display->fb, 0, 0, WINDOW_SIZE, WINDOW_SIZE, cell_palette[COLOR_EMPTY]);
+            display->cache_valid = true;
+        }
+        fb_render_cells(&display->fb, snapshot->cells, viewport);
+        if (profiler->overlay) {
+            draw_profiler_overlay(display, snapshot);
+        }
+        profiler_record(profiler, PHASE_DRAW, start);
+        
+        start = profiler_now();
+        SDL_UpdateTexture(display->fb_texture, NULL, display->fb.pixels,
+                          display->fb.pitch * (int)sizeof(uint32_t));
+        SDL_RenderCopy(display->renderer, display->fb_texture, NULL, NULL);
+        SDL_RenderPresent(display->renderer);
+        profiler_record(profiler, PHASE_PRESENT, start);
+        return;
+    }
+    
+    bool static_changed = !display->cache_valid || moved ||
+                          display->static_version != snapshot->static_version;
+    bool full = !display->frame || static_changed;
+    
+    if (full) {
+        draw_full(display, snapshot, static_changed);
+    } else {
+        draw_dirty(display, snapshot);
+    }
+    memcpy(display->drawn, snapshot->cells, visible);
+    display->cache_valid = true;
+    profiler_record(profiler, PHASE_DRAW, start);
     
-    SDL_RenderPresent(game->renderer);
-}
\ No newline at end of file
+    // Le panneau est dessiné sur l'écran, jamais dans le cache
+    start = profiler_now();
+    if (display->frame) {
+        SDL_SetRenderTarget(display->renderer, NULL);
+        SDL_RenderCopy(display->renderer, display->frame, NULL, NULL);
+    }
+    if (profiler->overlay) {
+        draw_profiler_overlay(display, snapshot);
+    }
+    SDL_RenderPresent(display->renderer);
+    profiler_record(profiler, PHASE_PRESENT, start);
+}
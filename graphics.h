@@ -3,12 +3,19 @@
 
 #include "snake.h"
 
+// Prototypes pour la fenêtre SDL
+bool init_display(Display *display, bool software);
+void free_display(Display *display);
+void invalidate_display(Display *display);
+
 // Prototypes pour l'affichage graphique
-void handle_events(Game *game);
-void render_game(Game *game);
+void attach_scenes(Display *display, Game *game, Simulation *simulation);
+bool handle_events(Display *display, Game *game);
+void render_game(Display *display, const Snapshot *snapshot);
 
 // Prototypes pour le menu
-void show_menu(Game *game);
-void render_menu(Game *game, int selected_option);
+MenuState menu_event(Menu *menu, const SDL_Event *event, bool *redraw);
+void draw_menu(Display *display, Menu *menu);
+void render_menu(Display *display, int selected_option);
 
-#endif
\ No newline at end of file
+#endif
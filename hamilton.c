@@ -0,0 +1,481 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hamilton.h"
+
+static const int dx[4] = {0, 1, 0, -1};
+static const int dy[4] = {-1, 0, 1, 0};
+
+#define BLOCK_VISITED 16   // Bit de links : bloc déjà atteint par le parcours
+#define NOT_VISITED 4      // next d'une case hors circuit pas encore atteinte par un parcours
+#define ON_DETOUR 5        // next d'une case hors circuit déjà prise par l'aller du détour
+
+void init_hamilton(Hamilton *hamilton) {
+    memset(hamilton, 0, sizeof(*hamilton));
+    hamilton->last_tick = -2;
+    init_ai(&hamilton->ai);
+}
+
+static void free_tables(Hamilton *hamilton) {
+    free(hamilton->order);
+    free(hamilton->next);
+    free(hamilton->links);
+    free(hamilton->queue);
+    free(hamilton->detour);
+    hamilton->order = NULL;
+    hamilton->next = NULL;
+    hamilton->links = NULL;
+    hamilton->queue = NULL;
+    hamilton->detour = NULL;
+    hamilton->detour_length = 0;
+    hamilton->size = 0;
+    hamilton->cycle_length = 0;
+}
+
+void free_hamilton(Hamilton *hamilton) {
+    free_tables(hamilton);
+    free_ai(&hamilton->ai);
+}
+
+static bool reserve_hamilton(Hamilton *hamilton, int size) {
+    if (hamilton->size == size) return true;
+
+    free_tables(hamilton);
+    size_t cells = (size_t)size * size;
+    size_t blocks = (size_t)((size - 2) / 2) * ((size - 2) / 2) + 1;
+    hamilton->order = malloc(cells * sizeof(int));
+    hamilton->next = malloc(cells);
+    hamilton->links = malloc(blocks);
+    hamilton->queue = malloc(cells * sizeof(int));
+    hamilton->detour = malloc(cells);
+
+    if (!hamilton->order || !hamilton->next || !hamilton->links || !hamilton->queue ||
+        !hamilton->detour) {
+        printf("Erreur: memoire insuffisante pour le circuit (map %dx%d)\n", size, size);
+        free_tables(hamilton);
+        return false;
+    }
+    hamilton->size = size;
+    return true;
+}
+
+// Voisine d'une case, avec la même téléportation aux bords que move_snake
+static int neighbor(const GameMap *map, int cell, int direction) {
+    int x = cell % map->size + dx[direction];
+    int y = cell / map->size + dy[direction];
+    if (x < 0) x = map->size - 1;
+    if (x >= map->size) x = 0;
+    if (y < 0) y = map->size - 1;
+    if (y >= map->size) y = 0;
+    return cell_index(map, x, y);
+}
+
+// Un bloc 2x2 de l'intérieur est utilisable si aucune de ses cases n'est un mur ou un obstacle
+static bool block_free(const GameMap *map, int bx, int by) {
+    int x = 1 + 2 * bx;
+    int y = 1 + 2 * by;
+    for (int k = 0; k < 4; k++) {
+        char c = cell_at(map, cell_index(map, x + k % 2, y + k / 2));
+        if (c == 'W' || c == 'O') return false;
+    }
+    return true;
+}
+
+// Arbre couvrant des blocs libres (parcours en largeur depuis le bloc de start),
+// puis contour de l'arbre : chaque case reçoit la direction de la suivante.
+// Tout est linéaire en nombre de cases.
+bool build_hamilton(Hamilton *hamilton, GameMap *map, Point start) {
+    int size = map->size;
+    if (!reserve_hamilton(hamilton, size)) return false;
+
+    int side = (size - 2) / 2;   // Blocs par côté
+    hamilton->map_version = map->static_version;
+    hamilton->cycle_length = 0;
+    for (int i = 0; i < size * size; i++) {
+        hamilton->order[i] = -1;
+        hamilton->next[i] = NOT_VISITED;
+    }
+    if (side == 0) return true;
+    memset(hamilton->links, 0, (size_t)side * side);
+
+    // Composantes de blocs libres, rangées l'une après l'autre dans queue ; le circuit
+    // est construit sur la plus grande (celle de start en cas d'égalité)
+    int start_block = -1;
+    int sx = (start.x - 1) / 2;
+    int sy = (start.y - 1) / 2;
+    if (start.x >= 1 && start.y >= 1 && sx < side && sy < side) {
+        start_block = sy * side + sx;
+    }
+    
+    int count = 0;
+    int best_first = 0;
+    int best_count = 0;
+    for (int b = -1; b < side * side; b++) {
+        int root = b < 0 ? start_block : b;
+        if (root < 0 || (hamilton->links[root] & BLOCK_VISITED) ||
+            !block_free(map, root % side, root / side)) continue;
+        
+        int first = count;
+        int head = count;
+        hamilton->queue[count++] = root;
+        hamilton->links[root] = BLOCK_VISITED;
+        while (head < count) {
+            int block = hamilton->queue[head++];
+            int bx = block % side;
+            int by = block / side;
+            for (int d = 0; d < 4; d++) {
+                int nx = bx + dx[d];
+                int ny = by + dy[d];
+                if (nx < 0 || nx >= side || ny < 0 || ny >= side) continue;
+
+                int other = ny * side + nx;
+                if ((hamilton->links[other] & BLOCK_VISITED) || !block_free(map, nx, ny)) continue;
+                hamilton->links[block] |= 1 << d;
+                hamilton->links[other] |= BLOCK_VISITED | (1 << ((d + 2) % 4));
+                hamilton->queue[count++] = other;
+            }
+        }
+        if (count - first > best_count) {
+            best_first = first;
+            best_count = count - first;
+        }
+    }
+    if (best_count == 0) return true;
+
+    // Contour dans le sens antihoraire : chaque bloc tourne sur lui-même,
+    // et passe dans le bloc voisin là où l'arbre les relie
+    for (int i = best_first; i < best_first + best_count; i++) {
+        int block = hamilton->queue[i];
+        int links = hamilton->links[block];
+        int x = 1 + 2 * (block % side);
+        int y = 1 + 2 * (block / side);
+        hamilton->next[cell_index(map, x, y)] = (links & 8) ? 3 : 2;
+        hamilton->next[cell_index(map, x, y + 1)] = (links & 4) ? 2 : 1;
+        hamilton->next[cell_index(map, x + 1, y + 1)] = (links & 2) ? 1 : 0;
+        hamilton->next[cell_index(map, x + 1, y)] = (links & 1) ? 0 : 3;
+    }
+
+    int first = hamilton->queue[best_first];
+    int origin = cell_index(map, 1 + 2 * (first % side), 1 + 2 * (first / side));
+    int cell = origin;
+    int rank = 0;
+    hamilton->origin = origin;
+    do {
+        hamilton->order[cell] = rank++;
+        cell = neighbor(map, cell, hamilton->next[cell]);
+    } while (cell != origin && rank < 4 * best_count);
+    hamilton->cycle_length = rank;
+    return true;
+}
+
+// Nombre de pas pour aller de from à to en suivant le circuit
+static int forward(const Hamilton *hamilton, int from, int to) {
+    int steps = hamilton->order[to] - hamilton->order[from];
+    return steps < 0 ? steps + hamilton->cycle_length : steps;
+}
+
+static bool safe(const GameMap *map, int cell) {
+    char c = cell_at(map, cell);
+    return c != 'W' && c != 'O' && !body_at(map, cell);
+}
+
+// Case où la tête peut entrer ce tick : libre, ou la queue (qui avance, il n'y a pas de fruit dessus)
+static bool enterable(const GameMap *map, Snake *snake, int cell) {
+    Point tail = snake->body[snake->tail];
+    return safe(map, cell) || (snake->length > 2 && cell == cell_index(map, tail.x, tail.y));
+}
+
+// Fruit visé s'il est sur le circuit : le plus proche devant la tête
+static int choose_target(const Hamilton *hamilton, Game *game, int head) {
+    GameMap *map = &game->map;
+    int target = -1;
+    int best = 0;
+
+    if (map->fruit.x >= 0) {
+        int fruit = cell_index(map, map->fruit.x, map->fruit.y);
+        if (hamilton->order[fruit] >= 0) {
+            target = fruit;
+            best = forward(hamilton, head, fruit);
+        }
+    }
+    if (map->special_fruit_timer > 0 && map->special_fruit.x >= 0) {
+        int special = cell_index(map, map->special_fruit.x, map->special_fruit.y);
+        if (hamilton->order[special] >= 0) {
+            int steps = forward(hamilton, head, special);
+            if (steps < map->special_fruit_timer && (target < 0 || steps < best)) {
+                target = special;
+            }
+        }
+    }
+    return target;
+}
+
+// Direction qui mène de cell à sa voisine other
+static int direction_to(const GameMap *map, int cell, int other) {
+    for (int d = 0; d < 3; d++) {
+        if (neighbor(map, cell, d) == other) return d;
+    }
+    return 3;
+}
+
+// Premier pas du plus court chemin de la tête au circuit par des cases sûres, -1
+// si le corps ou les obstacles l'enferment. Parcours en largeur en O(cases), mais
+// seulement tant que la tête est hors circuit (début de partie)
+static int path_to_cycle(Hamilton *hamilton, const GameMap *map, int head) {
+    int count = 0;
+    int found = -1;
+    hamilton->queue[count++] = head;
+    for (int i = 0; i < count && found < 0; i++) {
+        int cell = hamilton->queue[i];
+        for (int d = 0; d < 4; d++) {
+            int other = neighbor(map, cell, d);
+            if (!safe(map, other)) continue;
+            
+            int first = i == 0 ? d : hamilton->next[cell];
+            if (hamilton->order[other] >= 0) {
+                found = first;
+                break;
+            }
+            if (hamilton->next[other] != NOT_VISITED) continue;
+            hamilton->next[other] = first;
+            hamilton->queue[count++] = other;
+        }
+    }
+    for (int i = 1; i < count; i++) {
+        hamilton->next[hamilton->queue[i]] = NOT_VISITED;
+    }
+    return found;
+}
+
+// Parcours en largeur des cases hors circuit libres depuis from (la tête ou le
+// fruit) : next[case] reçoit la direction d'arrivée. S'arrête sur goal, ou sur
+// une case voisine du circuit dont la case du circuit est à moins de limit pas
+// devant head (*exit la reçoit). Retourne la case d'arrivée, -1 si aucune ;
+// les cases atteintes sont dans queue[0..*count).
+static int explore(Hamilton *hamilton, const GameMap *map, int from, int goal, int head, int limit,
+                   int *exit, int *count) {
+    *count = 0;
+    hamilton->queue[(*count)++] = from;
+    for (int i = 0; i < *count; i++) {
+        int cell = hamilton->queue[i];
+        for (int d = 0; d < 4; d++) {
+            int other = neighbor(map, cell, d);
+            if (goal < 0 && hamilton->order[other] >= 0) {
+                int steps = forward(hamilton, head, other);
+                if (steps > 0 && steps < limit && safe(map, other)) {
+                    *exit = other;
+                    return cell;
+                }
+                continue;
+            }
+            if (hamilton->order[other] >= 0 || hamilton->next[other] != NOT_VISITED ||
+                other == from || !safe(map, other)) continue;
+            hamilton->next[other] = (unsigned char)d;
+            hamilton->queue[(*count)++] = other;
+            if (other == goal) return other;
+        }
+    }
+    return -1;
+}
+
+// Remet à NOT_VISITED les cases atteintes par explore (sauf la première)
+static void clear_marks(Hamilton *hamilton, int count) {
+    for (int i = 1; i < count; i++) {
+        hamilton->next[hamilton->queue[i]] = NOT_VISITED;
+    }
+}
+
+// Écrit dans detour[at..] les directions du chemin qui mène à cell, à reculons
+// par les directions d'arrivée jusqu'à from ; retourne sa longueur
+static int trace_path(Hamilton *hamilton, const GameMap *map, int from, int cell, int at) {
+    int length = 0;
+    for (int c = cell; c != from; c = neighbor(map, c, (hamilton->next[c] + 2) % 4)) {
+        length++;
+    }
+    int k = at + length;
+    for (int c = cell; c != from; c = neighbor(map, c, (hamilton->next[c] + 2) % 4)) {
+        hamilton->detour[--k] = hamilton->next[c];
+    }
+    return length;
+}
+
+// Détour vers un fruit hors circuit, tête sur le circuit : aller de la tête au
+// fruit puis retour, par d'autres cases, vers une case du circuit assez près
+// devant la tête pour que la queue reste à HAMILTON_MARGIN cases (comme un
+// raccourci). Deux parcours en largeur limités aux cases hors circuit, faits
+// seulement quand la tête touche une case hors circuit.
+static bool plan_detour(Hamilton *hamilton, Game *game, int head, int fruit, int gap) {
+    GameMap *map = &game->map;
+    Snake *snake = &game->snake;
+    bool touches = false;
+    for (int d = 0; d < 4; d++) {
+        int other = neighbor(map, head, d);
+        touches |= hamilton->order[other] < 0 && safe(map, other);
+    }
+    if (!touches) return false;
+
+    int count;
+    int exit = -1;
+    if (explore(hamilton, map, head, fruit, head, 0, &exit, &count) < 0) {
+        clear_marks(hamilton, count);
+        return false;
+    }
+    int out = trace_path(hamilton, map, head, fruit, 0);
+    clear_marks(hamilton, count);
+
+    // Cases de l'aller interdites au retour
+    int c = head;
+    for (int k = 0; k < out; k++) {
+        c = neighbor(map, c, hamilton->detour[k]);
+        hamilton->next[c] = ON_DETOUR;
+    }
+    int last = explore(hamilton, map, fruit, -1, head, gap - HAMILTON_MARGIN, &exit, &count);
+    int back = 0;
+    if (last >= 0) {
+        back = trace_path(hamilton, map, fruit, last, out);
+        hamilton->detour[out + back++] = (unsigned char)direction_to(map, last, exit);
+    }
+    clear_marks(hamilton, count);
+    c = head;
+    for (int k = 0; k < out; k++) {
+        c = neighbor(map, c, hamilton->detour[k]);
+        hamilton->next[c] = NOT_VISITED;
+    }
+    // Quand la queue repasse par le détour, la tête ne mange que des cases libres
+    // du circuit : tout le corps, allongé, doit encore y tenir
+    if (last < 0 || snake->length + 1 + 2 * (out + back) + HAMILTON_MARGIN >= hamilton->cycle_length) {
+        return false;
+    }
+    hamilton->detour_length = out + back;
+    hamilton->detour_next = 0;
+    return true;
+}
+
+// Tête hors du circuit (départ sur un bloc exclu, circuit d'une autre composante) :
+// le plus court chemin vers le circuit s'il existe, sinon une case sûre, sur
+// le circuit si possible, sinon la plus proche de son origine
+static int rejoin(Hamilton *hamilton, Game *game, int head) {
+    GameMap *map = &game->map;
+    int best = game->snake.direction;
+    int best_rank = -1;
+
+    hamilton->ordered_steps = 0;
+    if (hamilton->cycle_length > 0 && hamilton->order[head] < 0) {
+        int path = path_to_cycle(hamilton, map, head);
+        if (path >= 0) return path;
+    }
+    for (int d = 0; d < 4; d++) {
+        int next = neighbor(map, head, d);
+        if (!enterable(map, &game->snake, next)) continue;
+
+        int rank = hamilton->order[next] >= 0 ? 2 * map->size : 0;
+        if (hamilton->cycle_length > 0) {
+            rank -= abs(next % map->size - hamilton->origin % map->size) +
+                    abs(next / map->size - hamilton->origin / map->size);
+        }
+        if (best_rank == -1 || rank > best_rank) {
+            best = d;
+            best_rank = rank;
+        }
+    }
+    return best;
+}
+
+// Décision en O(1) sur le circuit : case suivante, ou raccourci vers le fruit qui
+// ne dépasse ni le fruit ni la queue (à HAMILTON_MARGIN cases près). Un fruit
+// hors circuit est atteint par un détour (plan_detour) ; une map sans circuit
+// utilisable passe par le joueur A*.
+int hamilton_decide(Hamilton *hamilton, Game *game) {
+    GameMap *map = &game->map;
+    Snake *snake = &game->snake;
+    Point head_point = snake_head(snake);
+    int head = cell_index(map, head_point.x, head_point.y);
+
+    if (game->ticks == 0 || hamilton->size != map->size ||
+        hamilton->map_version != map->static_version) {
+        if (!build_hamilton(hamilton, map, head_point)) return snake->direction;
+        hamilton->ordered_steps = 0;
+        // Circuit trop court pour le serpent de départ (obstacles) : joué sans circuit
+        if (hamilton->cycle_length <= snake->length + HAMILTON_MARGIN) {
+            hamilton->cycle_length = 0;
+        }
+    }
+    if (game->ticks != hamilton->last_tick + 1) {
+        hamilton->ordered_steps = 0;
+    }
+    hamilton->last_tick = game->ticks;
+
+    if (hamilton->cycle_length == 0) {
+        hamilton->ai_decisions++;
+        return ai_decide(&hamilton->ai, game);
+    }
+
+    // Détour en cours vers un fruit hors circuit
+    if (hamilton->detour_next < hamilton->detour_length) {
+        int d = hamilton->detour[hamilton->detour_next++];
+        if (enterable(map, snake, neighbor(map, head, d))) return d;
+    }
+    hamilton->detour_length = 0;
+    
+    if (hamilton->order[head] < 0) {
+        return rejoin(hamilton, game, head);
+    }
+
+    // Tant que tout le corps n'est pas posé dans l'ordre du circuit, pas de raccourci
+    int next_direction = hamilton->next[head];
+    if (hamilton->ordered_steps < snake->length) {
+        if (!enterable(map, snake, neighbor(map, head, next_direction))) {
+            return rejoin(hamilton, game, head);
+        }
+        hamilton->ordered_steps++;
+        return next_direction;
+    }
+    if (hamilton->ordered_steps <= snake->length) {
+        hamilton->ordered_steps++;
+    }
+
+    Point tail_point = snake->body[snake->tail];
+    int tail = cell_index(map, tail_point.x, tail_point.y);
+    if (hamilton->order[tail] < 0) {
+        return next_direction;
+    }
+    int gap = forward(hamilton, head, tail);
+    int target = choose_target(hamilton, game, head);
+    if (target < 0 && map->fruit.x >= 0 &&
+        plan_detour(hamilton, game, head, cell_index(map, map->fruit.x, map->fruit.y), gap)) {
+        // Le corps repasse ensuite entièrement dans l'ordre du circuit avant tout raccourci
+        hamilton->detours++;
+        hamilton->detour_next = 1;
+        hamilton->ordered_steps = 0;
+        return hamilton->detour[0];
+    }
+    if (target < 0 || snake->length >= hamilton->cycle_length / 2) {
+        return next_direction;
+    }
+
+    int to_target = forward(hamilton, head, target);
+    int best = next_direction;
+    int best_skip = 1;
+    for (int d = 0; d < 4; d++) {
+        int next = neighbor(map, head, d);
+        if (hamilton->order[next] < 0) continue;
+
+        int skip = forward(hamilton, head, next);
+        if (skip <= best_skip || skip > to_target || skip >= gap - HAMILTON_MARGIN) continue;
+        if (!safe(map, next)) continue;
+        best = d;
+        best_skip = skip;
+    }
+    return best;
+}
+
+// Partie qui ne progresse plus (map sans circuit, départ enfermé) : aucun fruit
+// mangé depuis deux fois le nombre de cases. À appeler après chaque update_game ;
+// l'appelant arrête alors la partie.
+bool hamilton_stalled(Hamilton *hamilton, Game *game) {
+    if (game->score != hamilton->progress_score || game->ticks <= 1) {
+        hamilton->progress_score = game->score;
+        hamilton->progress_tick = game->ticks;
+    }
+    return game->ticks - hamilton->progress_tick > 2L * game->map.size * game->map.size;
+}
@@ -0,0 +1,51 @@
+#ifndef HAMILTON_H
+#define HAMILTON_H
+
+#include <stdbool.h>
+#include "game.h"
+#include "ai.h"
+
+// Joueur sur cycle hamiltonien : le serpent suit un circuit qui passe une fois
+// par chaque case du circuit, et ne peut pas s'y mordre tant qu'il y reste. Le circuit est le contour
+// d'un arbre couvrant de blocs 2x2 ; les blocs touchés par un mur ou un obstacle
+// (et la dernière ligne ou colonne si l'intérieur est impair) restent hors circuit,
+// ainsi que les blocs libres séparés du reste par des obstacles.
+// Des raccourcis vers le fruit sont pris tant qu'ils gardent l'ordre du circuit.
+// Les fruits apparaissent partout : un fruit hors circuit est atteint par un
+// détour qui ne passe que par des cases hors circuit et revient sur le circuit
+// devant la tête, comme un raccourci. Un fruit qu'aucun détour n'atteint (cul-de-sac)
+// bloque la partie. Sans circuit, ou avec un circuit trop court pour le serpent de
+// départ, le joueur A* (ai.c) joue seul. Le serpent peut donc mourir : départ
+// enfermé par les obstacles, joueur A*, ou fruits mangés à la suite pendant que la
+// queue repasse par un détour.
+
+#define HAMILTON_MARGIN 4   // Cases gardées libres entre la tête et la queue après un raccourci
+
+typedef struct Hamilton {
+    int size;                   // Taille de map des tableaux (0 : non alloués)
+    unsigned int map_version;   // static_version de la map pour laquelle le circuit a été construit
+    int cycle_length;           // Nombre de cases du circuit (0 : aucun circuit)
+    int origin;                 // Case de rang 0
+    int *order;                 // Rang de chaque case sur le circuit, -1 hors circuit
+    unsigned char *next;        // Direction de la case suivante sur le circuit (hors circuit : marques de rejoin)
+    unsigned char *links;       // Blocs voisins reliés dans l'arbre (bits haut, droite, bas, gauche)
+    int *queue;                 // File des parcours (blocs, puis cases hors circuit)
+    unsigned char *detour;      // Directions du détour en cours vers un fruit hors circuit
+    int detour_length;
+    int detour_next;
+    long last_tick;
+    int ordered_steps;          // Pas consécutifs dans l'ordre du circuit
+    int progress_score;         // Score au dernier fruit mangé (voir hamilton_stalled)
+    long progress_tick;
+    long detours;               // Détours pris vers un fruit hors circuit
+    Ai ai;                      // Map sans circuit
+    long ai_decisions;          // Décisions confiées au joueur A*
+} Hamilton;
+
+void init_hamilton(Hamilton *hamilton);
+void free_hamilton(Hamilton *hamilton);
+bool build_hamilton(Hamilton *hamilton, GameMap *map, Point start);
+int hamilton_decide(Hamilton *hamilton, Game *game);
+bool hamilton_stalled(Hamilton *hamilton, Game *game);
+
+#endif
@@ -0,0 +1,537 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "game.h"
+#include "batch.h"
+#include "runner.h"
+#include "replay.h"
+#include "framebuffer.h"
+#include "ai.h"
+#include "hamilton.h"
+#include "multisnake.h"
+#include "scene.h"
+
+// Simulation sans affichage : enchaîne des parties aussi vite que possible
+// et mesure le nombre de ticks par seconde de la logique du jeu.
+
+#define SOAK_GAME_TICKS 20000       // Durée maximale d'une partie de --soak
+#define SOAK_RSS_SLACK (256 * 1024) // Croissance tolérée de la mémoire résidente
+#define MULTI_CHECK_TICKS 1000      // Vérification complète de --snakes tous les N ticks
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Joueur glouton : se rapproche du fruit en évitant les cases mortelles immédiates
+static int greedy_direction(Game *game) {
+    static const int dx[4] = {0, 1, 0, -1};
+    static const int dy[4] = {-1, 0, 1, 0};
+
+    Point head = snake_head(&game->snake);
+    Point target = game->map.special_fruit_timer > 0 ? game->map.special_fruit : game->map.fruit;
+    int best = game->snake.direction;
+    int best_distance = -1;
+
+    for (int d = 0; d < 4; d++) {
+        if (d == (game->snake.direction + 2) % 4) continue;
+
+        int x = head.x + dx[d];
+        int y = head.y + dy[d];
+        char cell = get_cell(&game->map, x, y);
+        if (cell == 'W' || cell == 'O' || is_body(&game->map, x, y)) continue;
+
+        int distance = abs(target.x - x) + abs(target.y - y);
+        if (best_distance < 0 || distance < best_distance) {
+            best = d;
+            best_distance = distance;
+        }
+    }
+
+    return best;
+}
+
+static void usage(const char *name) {
+    printf("Usage: %s [--size N] [--difficulty 1-3] [--ticks N] [--seed N] [--batch N] [--record fichier] [--ai | --hamilton]\n", name);
+    printf("       %s --replay fichier\n", name);
+    printf("       %s --fb-bench [--size N]   (rendu logiciel, 1 pixel par case)\n", name);
+    printf("       %s --threads N [--games N] [--episodes N] [--size N] [--difficulty 1-3]\n", name);
+    printf("       %s --scale [--games N] [--episodes N] [--size N] [--difficulty 1-3]\n", name);
+    printf("       %s --soak N [--seed N]   (N allers-retours menu/partie, mémoire résidente)\n", name);
+    printf("       %s --snakes N [--size N] [--ticks N] [--seed N]   (N bots sur la même map)\n", name);
+}
+
+// Mémoire résidente du processus en octets (0 si /proc indisponible)
+static long resident_bytes(void) {
+    FILE *file = fopen("/proc/self/statm", "r");
+    long size = 0;
+    long resident = 0;
+    if (!file) return 0;
+    if (fscanf(file, "%ld %ld", &size, &resident) != 2) resident = 0;
+    fclose(file);
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+// Crochets de --soak : pas de thread de simulation, la boucle joue elle-même
+// les ticks dans la scène de jeu. Arrêts et reprises doivent alterner.
+typedef struct SoakState {
+    bool playing;
+    bool error;
+    long restarts;
+} SoakState;
+
+static void soak_stop(void *context) {
+    SoakState *state = context;
+    if (!state->playing) state->error = true;
+    state->playing = false;
+}
+
+static void soak_resume(void *context) {
+    SoakState *state = context;
+    if (state->playing) state->error = true;
+    state->playing = true;
+}
+
+static void soak_entered(void *context, Scene scene) {
+    (void)context;
+    (void)scene;
+}
+
+static void soak_restarted(void *context) {
+    SoakState *state = context;
+    state->restarts++;
+}
+
+// Ticks de la scène de jeu jusqu'à la défaite (ou SOAK_GAME_TICKS), avec une
+// pause au milieu ; retourne le nombre de ticks joués
+static long soak_play(Scenes *scenes, SoakState *state) {
+    Game *game = scenes->game;
+    while (game->running && game->ticks < SOAK_GAME_TICKS) {
+        if (game->ticks == 100) {
+            scene_toggle_pause(scenes);
+            scene_toggle_pause(scenes);
+        }
+        if (!state->playing || scenes->scene != SCENE_PLAYING) {
+            state->error = true;
+            break;
+        }
+        change_direction(&game->snake, greedy_direction(game));
+        update_game(game);
+    }
+    set_scene(scenes, SCENE_GAME_OVER);
+    return game->ticks;
+}
+
+// Endurance des changements de scène de la version SDL, par les mêmes
+// transitions (scene.h) : chaque cycle démarre une partie depuis le menu
+// (option tournante), la joue jusqu'à la défaite, la rejoue une fois, puis
+// revient au menu. La mémoire résidente ne doit pas grandir une fois chaque
+// option jouée.
+static int run_soak(long cycles, uint64_t seed) {
+    Game game;
+    SoakState state = {false, false, 0};
+    SceneHooks hooks = {soak_stop, soak_resume, soak_entered, soak_restarted, &state};
+    Scenes scenes;
+
+    game.arena = (Arena){0};
+    game.input = (InputQueue){0};
+    game.board_size = 0;
+    game.seed = seed;
+    if (!reserve_game(&game, MENU_MAX_SIZE)) {
+        return 1;
+    }
+    init_scenes(&scenes, &game, hooks);
+
+    long ticks = 0;
+    long baseline = 0;
+    double start = now_seconds();
+    for (long c = 0; c < cycles && !state.error; c++) {
+        if (!scene_start_game(&scenes, (int)(c % MENU_OPTIONS))) {
+            free_game(&game);
+            return 1;
+        }
+        ticks += soak_play(&scenes, &state);
+        scene_replay(&scenes);
+        ticks += soak_play(&scenes, &state);
+        scene_back_to_menu(&scenes);
+        if (scenes.scene != SCENE_MENU || state.playing) state.error = true;
+        // Mesure de référence quand chaque option a été jouée une fois
+        if (c == MENU_OPTIONS - 1 || cycles < MENU_OPTIONS) baseline = resident_bytes();
+    }
+    double elapsed = now_seconds() - start;
+    long resident = resident_bytes();
+    free_game(&game);
+
+    if (state.error) {
+        printf("Erreur: enchainement des scenes incoherent\n");
+        return 1;
+    }
+    printf("%ld cycles menu/partie (%ld parties), %ld ticks en %.3f s\n", cycles, state.restarts, ticks, elapsed);
+    printf("Memoire residente: %ld Kio apres le premier tour du menu, %ld Kio a la fin\n",
+           baseline / 1024, resident / 1024);
+
+    if (resident - baseline > SOAK_RSS_SLACK) {
+        printf("Erreur: la memoire residente a augmente de %ld Kio\n", (resident - baseline) / 1024);
+        return 1;
+    }
+    return 0;
+}
+
+// N bots sur une seule map, relancés à leur mort ; l'état partagé est vérifié
+// en entier tous les MULTI_CHECK_TICKS ticks
+static int run_multi(int count, int size, long ticks, uint64_t seed) {
+    MultiGame game;
+
+    if (!create_multi_game(&game, size, count, 0, seed)) {
+        return 1;
+    }
+
+    long moves = 0;
+    double elapsed = 0;
+    for (long t = 0; t < ticks; t++) {
+        double start = now_seconds();
+        moves += game.count;
+        moves -= step_multi_game(&game);
+        elapsed += now_seconds() - start;
+
+        if ((t + 1) % MULTI_CHECK_TICKS == 0 || t + 1 == ticks) {
+            if (!check_multi_game(&game)) {
+                printf("Erreur: etat incoherent au tick %ld\n", game.ticks);
+                free_multi_game(&game);
+                return 1;
+            }
+        }
+    }
+
+    printf("%d serpents sur une map %dx%d, %ld ticks en %.3f s : %.0f ticks/s, %.0f deplacements/s\n",
+           count, size, size, game.ticks, elapsed, game.ticks / elapsed, moves / elapsed);
+    printf("Morts tete contre tete: %ld, contre un obstacle ou un corps: %ld, reapparitions: %ld\n",
+           game.head_on_deaths, game.crash_deaths, game.respawns);
+    printf("Fruits manges: %ld, plus long serpent: %d\n", game.fruits_eaten, multi_longest(&game));
+    free_multi_game(&game);
+    return 0;
+}
+
+// Parties réparties sur plusieurs threads avec relance automatique
+static int run_threads(RunnerConfig *config, bool print_details) {
+    RunnerStats stats;
+
+    double start = now_seconds();
+    if (!run_parallel(config, &stats)) {
+        return 1;
+    }
+    double elapsed = now_seconds() - start;
+
+    if (print_details) {
+        printf("%d threads, %d parties simultanees %dx%d, difficulte %d\n",
+               config->threads, config->games, config->size, config->size, config->difficulty);
+        printf("%ld pas de jeu en %.3f s : %.0f pas/s\n", stats.steps, elapsed, stats.steps / elapsed);
+        if (stats.episodes > 0) {
+            printf("%ld parties terminees, score moyen %.1f, longueur moyenne %.1f, meilleur score %d\n",
+                   stats.episodes, (double)stats.total_score / stats.episodes,
+                   (double)stats.total_length / stats.episodes, stats.best_score);
+        }
+        if (stats.stalled > 0) {
+            printf("%ld parties arretees faute de progres (hors moyennes)\n", stats.stalled);
+        }
+    } else {
+        printf("%7d %14.0f %10.3f\n", config->threads, stats.steps / elapsed, elapsed);
+    }
+    return 0;
+}
+
+// Rendu logiciel d'une map size x size (une case = un pixel) avec chaque jeu d'instructions
+static int run_fb_bench(int size, int difficulty, uint64_t seed) {
+    static const char *backends[] = {"scalaire", "sse2", "avx2"};
+    Game game;
+    Framebuffer fb;
+
+    if (!init_game(&game, size, difficulty, seed)) {
+        return 1;
+    }
+    // Serpent long en serpentin pour avoir des lignes de couleurs variées
+    for (int y = 2; y < size - 2 && game.snake.length < size * size / 4; y += 2) {
+        for (int x = 2; x < size - 2; x++) {
+            int index = cell_index(&game.map, x, y);
+            if (cell_at(&game.map, index) == ' ' && !body_at(&game.map, index)) {
+                add_segment(&game.snake, x, y);
+                set_body_at(&game.map, index, true);
+            }
+        }
+    }
+    if (!create_framebuffer(&fb, size, size)) {
+        free_game(&game);
+        return 1;
+    }
+
+    Viewport viewport = {0, 0, size, size, 1};
+    int frames = 20000000 / (size * size) + 10;
+    printf("Rendu logiciel %dx%d, %d images\n", size, size, frames);
+    for (int b = 0; b < 3; b++) {
+        if (!fb_select_backend(backends[b])) continue;
+
+        double start = now_seconds();
+        for (int f = 0; f < frames; f++) {
+            fb_render_game(&fb, &game, &viewport);
+        }
+        double elapsed = now_seconds() - start;
+        printf("%-9s %8.3f ms/image %8.0f Mpixels/s\n", fb_backend_name(),
+               elapsed * 1000 / frames, (double)size * size * frames / elapsed / 1e6);
+    }
+
+    free_framebuffer(&fb);
+    free_game(&game);
+    return 0;
+}
+
+// Mesure de la montée en charge de 1 thread à tous les coeurs
+static int run_scaling(RunnerConfig *config) {
+    int cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+
+    printf("threads          pas/s      duree\n");
+    for (int t = 1; t <= cores; t++) {
+        config->threads = t;
+        if (run_threads(config, false) != 0) return 1;
+    }
+    return 0;
+}
+
+// Parties par lots : ticks est le nombre total de pas de jeu, toutes parties confondues
+static int run_batch(int count, int size, int difficulty, long ticks, uint64_t seed) {
+    Batch batch;
+    if (!create_batch(&batch, count, size, difficulty, seed)) {
+        return 1;
+    }
+
+    int *actions = malloc(count * sizeof(int));
+    if (!actions) {
+        printf("Erreur: memoire insuffisante (%zu octets)\n", count * sizeof(int));
+        free_batch(&batch);
+        return 1;
+    }
+    long steps = 0;
+    long games = 0;
+    long total_score = 0;
+
+    double start = now_seconds();
+    while (steps < ticks) {
+        for (int i = 0; i < count; i++) {
+            actions[i] = greedy_direction(&batch.games[i]);
+        }
+        steps += step_batch(&batch, actions);
+
+        for (int i = 0; i < count; i++) {
+            if (!batch.alive[i]) {
+                total_score += batch.scores[i];
+                games++;
+                reset_batch_game(&batch, i);
+            }
+        }
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("Lot de %d parties %dx%d, difficulte %d\n", count, size, size, difficulty);
+    printf("%ld pas de jeu en %.3f s : %.0f pas/s\n", steps, elapsed, steps / elapsed);
+    if (games > 0) {
+        printf("%ld parties terminees, score moyen %.1f\n", games, (double)total_score / games);
+    }
+
+    free(actions);
+    free_batch(&batch);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    int size = 20;
+    int difficulty = 2;
+    long ticks = 10000000;
+    uint64_t seed = (uint64_t)time(NULL);
+    int batch_count = 0;
+    int threads = 0;
+    bool scale = false;
+    int parallel_games = 1024;
+    long episodes = 100000;
+    const char *record_path = NULL;
+    bool fb_bench = false;
+    bool use_ai = false;
+    bool use_hamilton = false;
+    long soak_cycles = 0;
+    int snakes = 0;
+    bool snakes_set = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            size = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) {
+            difficulty = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            ticks = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scale") == 0) {
+            scale = true;
+        } else if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) {
+            parallel_games = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--episodes") == 0 && i + 1 < argc) {
+            episodes = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--ai") == 0) {
+            use_ai = true;
+        } else if (strcmp(argv[i], "--hamilton") == 0) {
+            use_hamilton = true;
+        } else if (strcmp(argv[i], "--soak") == 0 && i + 1 < argc) {
+            soak_cycles = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--snakes") == 0 && i + 1 < argc) {
+            snakes = atoi(argv[++i]);
+            snakes_set = true;
+        } else if (strcmp(argv[i], "--fb-bench") == 0) {
+            fb_bench = true;
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            return replay_verify(argv[++i]) ? 0 : 1;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (size < 8 || size > max_board_size()) {
+        printf("Taille de map invalide (entre 8 et %d)\n", max_board_size());
+        return 1;
+    }
+
+    if (soak_cycles > 0) {
+        return run_soak(soak_cycles, seed);
+    }
+
+    if (snakes_set && snakes < 1) {
+        printf("Nombre de serpents invalide (au moins 1)\n");
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (snakes > 0) {
+        return run_multi(snakes, size, ticks, seed);
+    }
+
+    if (fb_bench) {
+        return run_fb_bench(size, difficulty, seed);
+    }
+
+    if (batch_count > 0) {
+        return run_batch(batch_count, size, difficulty, ticks, seed);
+    }
+
+    if (threads > 0 || scale) {
+        if (parallel_games < 1 || episodes < 1) {
+            printf("Nombre de parties invalide (--games et --episodes au moins 1)\n");
+            usage(argv[0]);
+            return 1;
+        }
+        RunnerConfig config = {threads, parallel_games, size, difficulty, episodes, seed, greedy_direction};
+        return scale ? run_scaling(&config) : run_threads(&config, true);
+    }
+
+    Game game;
+    if (!init_game(&game, size, difficulty, seed)) {
+        return 1;
+    }
+
+    // --record : enregistre la première partie
+    ReplayWriter recorder = {NULL, 0, 0};
+    if (record_path && !replay_open_write(&recorder, record_path, &game)) {
+        free_game(&game);
+        return 1;
+    }
+
+    // --ai : joueur A* au lieu du joueur glouton
+    Ai ai;
+    init_ai(&ai);
+
+    // --hamilton : joueur sur cycle ; une partie qui ne progresse plus (voir
+    // hamilton_stalled) est arrêtée et comptée à part
+    Hamilton hamilton;
+    init_hamilton(&hamilton);
+    long stalled = 0;
+    long deaths = 0;
+    long wins = 0;
+    long filled = 0;        // Parties où le serpent a couvert tout le circuit
+    bool cycle_full = false;
+    int best_length = 0;
+
+    long games = 0;
+    long total_score = 0;
+    int best_score = 0;
+
+    double start = now_seconds();
+    for (long t = 0; t < ticks; t++) {
+        int direction;
+        if (use_ai) {
+            direction = ai_decide(&ai, &game);
+        } else if (use_hamilton) {
+            direction = hamilton_decide(&hamilton, &game);
+        } else {
+            direction = greedy_direction(&game);
+        }
+        change_direction(&game.snake, direction);
+        update_game(&game);
+        replay_record_tick(&recorder, &game);
+
+        if (game.snake.length > best_length) best_length = game.snake.length;
+        if (use_hamilton && hamilton.cycle_length > 0 && game.snake.length >= hamilton.cycle_length) {
+            cycle_full = true;
+        }
+        if (use_hamilton && game.running && hamilton_stalled(&hamilton, &game)) {
+            game.running = false;
+            stalled++;
+        } else if (game.won) {
+            wins++;
+        } else if (!game.running) {
+            deaths++;
+        }
+
+        if (!game.running) {
+            if (cycle_full) filled++;
+            cycle_full = false;
+            replay_close_write(&recorder, &game);
+            total_score += game.score;
+            if (game.score > best_score) best_score = game.score;
+            seed_game(&game, next_game_seed(&game));
+            reset_game(&game);
+            games++;
+        }
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("Map %dx%d, difficulte %d, graine %llu\n", size, size, difficulty, (unsigned long long)seed);
+    printf("%ld ticks en %.3f s : %.0f ticks/s\n", ticks, elapsed, ticks / elapsed);
+    if (games > 0) {
+        printf("%ld parties terminees, score moyen %.1f, meilleur score %d\n",
+               games, (double)total_score / games, best_score);
+    }
+
+    if (use_hamilton) {
+        int open = size * size - count_cells(&game.map, PLANE_WALL) - game.map.obstacles_count;
+        printf("Dernier plateau : circuit de %d cases sur %d libres ; longueur max %d, %ld decisions A* sans circuit\n",
+               hamilton.cycle_length, open, best_length, hamilton.ai_decisions);
+        printf("%ld circuits couverts, %ld victoires (plateau plein), %ld morts, %ld parties bloquees\n",
+               filled, wins, deaths, stalled);
+    }
+    ai_print_stats(&ai);
+
+    replay_close_write(&recorder, &game);
+    free_hamilton(&hamilton);
+    free_ai(&ai);
+    free_game(&game);
+    return 0;
+}
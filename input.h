@@ -0,0 +1,52 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// File des commandes de direction, entre la boucle d'événements (producteur)
+// et update_game (consommateur) : anneau sans verrou à un producteur et un
+// consommateur. head n'est écrit que par le producteur, tail que par le
+// consommateur ; les index croissent sans fin et sont pris modulo la capacité.
+
+#define INPUT_CAPACITY 16   // Puissance de deux ; au-delà, les appuis sont ignorés
+
+typedef struct InputCommand {
+    int direction;
+    uint64_t time;      // Instant de l'appui, horloge de profiler_now (ns)
+} InputCommand;
+
+typedef struct InputQueue {
+    InputCommand slots[INPUT_CAPACITY];
+    unsigned int head;  // Prochaine case à écrire
+    unsigned int tail;  // Prochaine case à lire
+} InputQueue;
+
+// Producteur : false si la file est pleine
+static inline bool input_push(InputQueue *queue, int direction, uint64_t time) {
+    unsigned int head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+    unsigned int tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    if (head - tail == INPUT_CAPACITY) return false;
+
+    queue->slots[head % INPUT_CAPACITY] = (InputCommand){direction, time};
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// Consommateur : false si la file est vide
+static inline bool input_pop(InputQueue *queue, InputCommand *command) {
+    unsigned int tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    unsigned int head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    if (head == tail) return false;
+
+    *command = queue->slots[tail % INPUT_CAPACITY];
+    __atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// Consommateur : oublie les commandes en attente (nouvelle partie)
+static inline void input_clear(InputQueue *queue) {
+    __atomic_store_n(&queue->tail, __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
+
+#endif
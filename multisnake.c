@@ -0,0 +1,334 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "multisnake.h"
+
+static const int dx[4] = {0, 1, 0, -1};
+static const int dy[4] = {-1, 0, 1, 0};
+
+// Case voisine dans une direction, avec la même téléportation aux bords que move_snake
+static int step_cell(const GameMap *map, Point from, int direction) {
+    int x = from.x + dx[direction];
+    int y = from.y + dy[direction];
+    if (x < 0) x = map->size - 1;
+    if (x >= map->size) x = 0;
+    if (y < 0) y = map->size - 1;
+    if (y >= map->size) y = 0;
+    return cell_index(map, x, y);
+}
+
+static bool open_cell(const GameMap *map, int index) {
+    char c = cell_at(map, index);
+    return c != 'W' && c != 'O' && !body_at(map, index);
+}
+
+static bool free_cell(const GameMap *map, int index) {
+    return cell_at(map, index) == ' ' && !body_at(map, index);
+}
+
+// Anneau plein : capacité doublée, segments recopiés de la queue à la tête
+static bool grow_snake(Snake *snake) {
+    int capacity = snake->capacity * 2;
+    Point *body = malloc((size_t)capacity * sizeof(Point));
+    if (!body) return false;
+
+    for (int i = 0; i < snake->length; i++) {
+        body[i] = snake->body[(snake->tail + i) % snake->capacity];
+    }
+    free(snake->body);
+    snake->body = body;
+    snake->capacity = capacity;
+    snake->tail = 0;
+    snake->head = snake->length - 1;
+    return true;
+}
+
+// Serpent de 3 cases vers la gauche (comme reset_snake) sur des cases libres tirées
+// au hasard ; le plateau est grand devant les serpents, quelques tirages suffisent
+static bool spawn_snake(MultiGame *game, int i) {
+    GameMap *map = &game->map;
+    int size = map->size;
+
+    for (int attempt = 0; attempt < MULTI_SPAWN_ATTEMPTS; attempt++) {
+        int x = 3 + rng_range(&map->rng, size - 4);
+        int y = 1 + rng_range(&map->rng, size - 2);
+        int index = cell_index(map, x, y);
+        if (!free_cell(map, index) || !free_cell(map, index - 1) || !free_cell(map, index - 2)) continue;
+
+        Snake *snake = &game->snakes[i];
+        reset_snake(snake, x, y);
+        for (int k = 0; k < 3; k++) {
+            set_body_at(map, index - k, true);
+        }
+        game->state[i] = SNAKE_ALIVE;
+        game->scores[i] = 0;
+        return true;
+    }
+    return false;
+}
+
+static void spawn_fruits(MultiGame *game) {
+    GameMap *map = &game->map;
+    int cells = map->size * map->size;
+
+    for (int attempt = 0; game->fruits < game->fruit_target && attempt < MULTI_SPAWN_ATTEMPTS * game->fruit_target;
+         attempt++) {
+        int index = rng_range(&map->rng, cells);
+        if (free_cell(map, index)) {
+            set_cell_at(map, index, 'F');
+            game->fruits++;
+        }
+    }
+}
+
+bool create_multi_game(MultiGame *game, int size, int count, int players, uint64_t seed) {
+    memset(game, 0, sizeof(*game));
+    int hash_size = 2;
+    while (hash_size < 2 * count) hash_size *= 2;
+
+    if (!arena_init(&game->arena, map_arena_size(size))) {
+        return false;
+    }
+    game->map = create_map(&game->arena, size);
+    rng_seed(&game->map.rng, seed);
+    spawn_obstacles(&game->map, size, 2);
+
+    game->count = count;
+    game->players = players;
+    game->fruit_target = count / 2 > 0 ? count / 2 : 1;
+    game->hash_mask = hash_size - 1;
+    game->snakes = calloc(count, sizeof(Snake));
+    game->state = calloc(count, 1);
+    game->targets = malloc(count * sizeof(int));
+    game->scores = calloc(count, sizeof(int));
+    game->hash_cells = malloc(hash_size * sizeof(int));
+    game->hash_counts = malloc(hash_size * sizeof(int));
+    game->hash_stamps = calloc(hash_size, sizeof(uint32_t));
+    if (!game->snakes || !game->state || !game->targets || !game->scores ||
+        !game->hash_cells || !game->hash_counts || !game->hash_stamps) {
+        printf("Erreur: memoire insuffisante pour %d serpents\n", count);
+        free_multi_game(game);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        Snake *snake = &game->snakes[i];
+        snake->body = malloc(MULTI_START_CAPACITY * sizeof(Point));
+        if (!snake->body) {
+            printf("Erreur: memoire insuffisante pour %d serpents\n", count);
+            free_multi_game(game);
+            return false;
+        }
+        snake->capacity = MULTI_START_CAPACITY;
+        spawn_snake(game, i);
+    }
+    spawn_fruits(game);
+    return true;
+}
+
+void free_multi_game(MultiGame *game) {
+    if (game->snakes) {
+        for (int i = 0; i < game->count; i++) {
+            free(game->snakes[i].body);
+        }
+    }
+    free(game->snakes);
+    free(game->state);
+    free(game->targets);
+    free(game->scores);
+    free(game->hash_cells);
+    free(game->hash_counts);
+    free(game->hash_stamps);
+    arena_free(&game->arena);
+    game->snakes = NULL;
+    game->count = 0;
+}
+
+// Bot en O(1) : prend un fruit voisin, sinon continue tout droit et tourne
+// de temps en temps ou devant un obstacle
+static void steer_bot(MultiGame *game, int i) {
+    GameMap *map = &game->map;
+    Snake *snake = &game->snakes[i];
+    Point head = snake_head(snake);
+    int options[3] = {snake->direction, (snake->direction + 1) % 4, (snake->direction + 3) % 4};
+
+    for (int k = 0; k < 3; k++) {
+        if (cell_at(map, step_cell(map, head, options[k])) == 'F') {
+            snake->direction = options[k];
+            return;
+        }
+    }
+    if (rng_range(&map->rng, 16) == 0) {
+        int turn = 1 + rng_range(&map->rng, 2);
+        options[turn] = options[0];
+        options[0] = snake->direction = (snake->direction + (turn == 1 ? 1 : 3)) % 4;
+    }
+    for (int k = 0; k < 3; k++) {
+        if (open_cell(map, step_cell(map, head, options[k]))) {
+            snake->direction = options[k];
+            return;
+        }
+    }
+}
+
+static uint32_t hash_slot(const MultiGame *game, int cell) {
+    return ((uint32_t)cell * 2654435761u) & (uint32_t)game->hash_mask;
+}
+
+// Une tête de plus vers cell
+static void hash_add(MultiGame *game, int cell) {
+    uint32_t slot = hash_slot(game, cell);
+    while (game->hash_stamps[slot] == game->generation) {
+        if (game->hash_cells[slot] == cell) {
+            game->hash_counts[slot]++;
+            return;
+        }
+        slot = (slot + 1) & (uint32_t)game->hash_mask;
+    }
+    game->hash_stamps[slot] = game->generation;
+    game->hash_cells[slot] = cell;
+    game->hash_counts[slot] = 1;
+}
+
+static int hash_count(const MultiGame *game, int cell) {
+    uint32_t slot = hash_slot(game, cell);
+    while (game->hash_stamps[slot] == game->generation) {
+        if (game->hash_cells[slot] == cell) return game->hash_counts[slot];
+        slot = (slot + 1) & (uint32_t)game->hash_mask;
+    }
+    return 0;
+}
+
+// Un tick pour tous les serpents ; retourne le nombre de morts
+int step_multi_game(MultiGame *game) {
+    GameMap *map = &game->map;
+    int deaths = 0;
+
+    // Nouvelle génération : la table du tick précédent devient caduque
+    if (++game->generation == 0) {
+        memset(game->hash_stamps, 0, (game->hash_mask + 1) * sizeof(uint32_t));
+        game->generation = 1;
+    }
+
+    // Directions et cases visées ; les queues des serpents qui ne mangent pas
+    // libèrent leur case avant que les têtes n'avancent (comme move_snake)
+    for (int i = 0; i < game->count; i++) {
+        if (game->state[i] != SNAKE_ALIVE) continue;
+        Snake *snake = &game->snakes[i];
+        if (i >= game->players) steer_bot(game, i);
+
+        int target = step_cell(map, snake_head(snake), snake->direction);
+        game->targets[i] = target;
+        hash_add(game, target);
+        if (cell_at(map, target) != 'F') {
+            Point tail = snake->body[snake->tail];
+            set_body_at(map, cell_index(map, tail.x, tail.y), false);
+            remove_tail(snake);
+        }
+    }
+
+    // Têtes en conflit : toutes celles qui visent la même case meurent
+    for (int i = 0; i < game->count; i++) {
+        if (game->state[i] == SNAKE_ALIVE && hash_count(game, game->targets[i]) > 1) {
+            game->state[i] = SNAKE_HEAD_ON;
+        }
+    }
+
+    // Têtes seules sur leur case : mur, obstacle ou corps (queues déjà libérées)
+    for (int i = 0; i < game->count; i++) {
+        if (game->state[i] != SNAKE_ALIVE) continue;
+        Snake *snake = &game->snakes[i];
+        int target = game->targets[i];
+
+        if (!open_cell(map, target)) {
+            game->state[i] = SNAKE_CRASHED;
+            continue;
+        }
+        if (cell_at(map, target) == 'F') {
+            set_cell_at(map, target, ' ');
+            game->fruits--;
+            game->fruits_eaten++;
+            game->scores[i] += 10;
+            if (snake->length == snake->capacity && !grow_snake(snake)) {
+                game->state[i] = SNAKE_CRASHED;
+                continue;
+            }
+        }
+        add_segment(snake, target % map->size, target / map->size);
+        set_body_at(map, target, true);
+    }
+
+    // Corps des serpents morts retirés, après tous les déplacements
+    for (int i = 0; i < game->count; i++) {
+        unsigned char state = game->state[i];
+        if (state != SNAKE_HEAD_ON && state != SNAKE_CRASHED) continue;
+
+        Snake *snake = &game->snakes[i];
+        while (snake->length > 0) {
+            Point p = snake->body[snake->tail];
+            set_body_at(map, cell_index(map, p.x, p.y), false);
+            remove_tail(snake);
+        }
+        if (state == SNAKE_HEAD_ON) {
+            game->head_on_deaths++;
+        } else {
+            game->crash_deaths++;
+        }
+        game->state[i] = SNAKE_DEAD;
+        deaths++;
+    }
+
+    // Réapparitions (essayées à chaque tick tant qu'elles échouent) et fruits
+    for (int i = 0; i < game->count; i++) {
+        if (game->state[i] == SNAKE_DEAD && spawn_snake(game, i)) {
+            game->respawns++;
+        }
+    }
+    spawn_fruits(game);
+
+    game->ticks++;
+    return deaths;
+}
+
+// Vérification complète, en O(cases + segments) : chaque segment vivant occupe
+// une case du plan des corps, aucune case n'est partagée, et les compteurs de
+// cases libres et de fruits sont justes
+bool check_multi_game(MultiGame *game) {
+    GameMap *map = &game->map;
+    long segments = 0;
+
+    for (int i = 0; i < game->count; i++) {
+        Snake *snake = &game->snakes[i];
+        if (game->state[i] == SNAKE_DEAD) {
+            if (snake->length != 0) return false;
+            continue;
+        }
+        for (int k = 0; k < snake->length; k++) {
+            Point p = snake->body[(snake->tail + k) % snake->capacity];
+            if (!body_at(map, cell_index(map, p.x, p.y))) return false;
+        }
+        segments += snake->length;
+    }
+
+    long free_cells = 0;
+    for (int w = 0; w < map->words; w++) {
+        uint64_t used = 0;
+        for (int plane = 0; plane < PLANE_COUNT; plane++) {
+            used |= map->planes[plane][w];
+        }
+        int bits = (w + 1) * 64 <= map->size * map->size ? 64 : map->size * map->size - w * 64;
+        free_cells += bits - __builtin_popcountll(used);
+    }
+
+    return count_cells(map, PLANE_BODY) == segments &&
+           count_cells(map, PLANE_FRUIT) == game->fruits &&
+           free_cells == map->free_count;
+}
+
+int multi_longest(const MultiGame *game) {
+    int longest = 0;
+    for (int i = 0; i < game->count; i++) {
+        if (game->snakes[i].length > longest) longest = game->snakes[i].length;
+    }
+    return longest;
+}
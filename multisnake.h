@@ -0,0 +1,59 @@
+#ifndef MULTISNAKE_H
+#define MULTISNAKE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+// Mode à plusieurs serpents : N serpents (joueurs puis bots) sur une seule map.
+// Les collisions tête-corps se lisent dans le plan d'occupation partagé de la
+// map, et les collisions tête-tête (deux têtes qui entrent dans la même case)
+// dans une table de hachage des cases visées, refaite à chaque tick : un tick
+// coûte O(nombre de serpents), sans comparer les serpents deux à deux.
+// Un tick se déroule en phases, pour que le résultat ne dépende pas de l'ordre
+// des serpents : queues libérées, têtes en conflit, têtes avancées, corps des
+// serpents morts retirés, puis réapparitions et fruits.
+
+#define MULTI_START_CAPACITY 16   // Anneau initial d'un serpent, doublé quand il est plein
+#define MULTI_SPAWN_ATTEMPTS 8    // Tirages au hasard pour placer un serpent ou un fruit
+
+enum {
+    SNAKE_DEAD,         // En attente de réapparition
+    SNAKE_ALIVE,
+    SNAKE_HEAD_ON,      // Mort ce tick : tête contre tête
+    SNAKE_CRASHED       // Mort ce tick : mur, obstacle ou corps
+};
+
+typedef struct MultiGame {
+    GameMap map;
+    Arena arena;            // Plans de la map
+    int count;
+    int players;            // Les serpents 0..players-1 sont dirigés par l'appelant
+    Snake *snakes;          // Anneaux alloués à part, agrandis à la demande
+    unsigned char *state;
+    int *targets;           // Case visée par la tête pendant le tick
+    int *scores;
+    int fruits;             // Fruits sur la map
+    int fruit_target;       // Fruits maintenus sur la map
+
+    // Table des cases visées : adressage ouvert, entrées valides si stamp == generation
+    int hash_mask;
+    int *hash_cells;
+    int *hash_counts;
+    uint32_t *hash_stamps;
+    uint32_t generation;
+
+    long ticks;
+    long head_on_deaths;
+    long crash_deaths;
+    long respawns;
+    long fruits_eaten;
+} MultiGame;
+
+bool create_multi_game(MultiGame *game, int size, int count, int players, uint64_t seed);
+void free_multi_game(MultiGame *game);
+int step_multi_game(MultiGame *game);
+bool check_multi_game(MultiGame *game);
+int multi_longest(const MultiGame *game);
+
+#endif
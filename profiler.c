@@ -0,0 +1,167 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "profiler.h"
+
+static const char *phase_names[PHASE_COUNT] = {
+    "handle_events", "update_game", "render_game", "draw", "present"
+};
+
+// Classe d'une valeur : exacte sous 8, puis 8 classes par puissance de deux
+static int bucket_of(uint32_t value) {
+    if (value < 8) return (int)value;
+    int octave = 31 - __builtin_clz(value);
+    return (octave - 2) * 8 + (int)((value >> (octave - 3)) & 7);
+}
+
+// Plus grande valeur de la classe
+static uint32_t bucket_limit(int bucket) {
+    if (bucket < 8) return (uint32_t)bucket;
+    int octave = bucket / 8 + 2;
+    uint64_t limit = ((uint64_t)(8 + bucket % 8 + 1) << (octave - 3)) - 1;
+    return limit > UINT32_MAX ? UINT32_MAX : (uint32_t)limit;
+}
+
+// Ajoute une valeur ; la plus ancienne sort de la fenêtre une fois celle-ci pleine
+void histogram_add(Histogram *histogram, uint32_t value) {
+    if (histogram->count == HISTOGRAM_WINDOW) {
+        histogram->buckets[bucket_of(histogram->window[histogram->next])]--;
+    } else {
+        histogram->count++;
+    }
+    histogram->window[histogram->next] = value;
+    histogram->buckets[bucket_of(value)]++;
+    histogram->next = (histogram->next + 1) % HISTOGRAM_WINDOW;
+}
+
+// Percentile (0-100) à la précision d'une classe, sans dépasser le maximum réel
+uint32_t histogram_percentile(const Histogram *histogram, double percentile) {
+    if (histogram->count == 0) return 0;
+
+    int rank = (int)(percentile / 100.0 * histogram->count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > histogram->count) rank = histogram->count;
+
+    int seen = 0;
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        seen += histogram->buckets[b];
+        if (seen >= rank) {
+            uint32_t limit = bucket_limit(b);
+            uint32_t max = histogram_max(histogram);
+            return limit < max ? limit : max;
+        }
+    }
+    return histogram_max(histogram);
+}
+
+uint32_t histogram_max(const Histogram *histogram) {
+    uint32_t max = 0;
+    for (int i = 0; i < histogram->count; i++) {
+        if (histogram->window[i] > max) max = histogram->window[i];
+    }
+    return max;
+}
+
+// trace_capacity = 0 : histogrammes seulement, pas de trace
+bool profiler_init(Profiler *profiler, int trace_capacity) {
+    memset(profiler, 0, sizeof(*profiler));
+    profiler->origin = profiler_now();
+
+    if (trace_capacity > 0) {
+        profiler->trace = malloc(trace_capacity * sizeof(TraceEvent));
+        if (!profiler->trace) {
+            printf("Erreur: memoire insuffisante pour la trace\n");
+            return false;
+        }
+        profiler->trace_capacity = trace_capacity;
+    }
+    return true;
+}
+
+void profiler_free(Profiler *profiler) {
+    free(profiler->trace);
+    profiler->trace = NULL;
+    profiler->trace_capacity = 0;
+}
+
+// Horloge monotone en nanosecondes
+uint64_t profiler_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Fin d'une phase commencée à start (valeur de profiler_now)
+void profiler_record(Profiler *profiler, int phase, uint64_t start) {
+    uint64_t end = profiler_now();
+    uint64_t duration = end - start;
+    if (duration > UINT32_MAX) duration = UINT32_MAX;
+
+    histogram_add(&profiler->phases[phase], (uint32_t)duration);
+
+    if (profiler->trace) {
+        TraceEvent *event = &profiler->trace[profiler->trace_count % profiler->trace_capacity];
+        event->start = start - profiler->origin;
+        event->duration = (uint32_t)duration;
+        event->phase = phase;
+        profiler->trace_count++;
+    }
+}
+
+const char *profiler_phase_name(int phase) {
+    return phase >= 0 && phase < PHASE_COUNT ? phase_names[phase] : "?";
+}
+
+// Résumé des dernières mesures de chaque phase, en microsecondes
+void profiler_print(const Profiler *profiler) {
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        const Histogram *histogram = &profiler->phases[p];
+        if (histogram->count == 0) continue;
+        printf("%-14s p50 %8.1f us  p99 %8.1f us  max %8.1f us\n", phase_names[p],
+               histogram_percentile(histogram, 50) / 1000.0,
+               histogram_percentile(histogram, 99) / 1000.0,
+               histogram_max(histogram) / 1000.0);
+    }
+}
+
+// Événements complets ("ph": "X"), temps en microsecondes. Un profileur par
+// thread : chacun a sa ligne (tid) et dans chaque ligne l'ordre est chronologique.
+// Les profileurs doivent partager la même origine.
+bool profiler_write_trace(const Profiler *const *profilers, int count, const char *path) {
+    bool traced = false;
+    for (int t = 0; t < count; t++) {
+        traced = traced || profilers[t]->trace;
+    }
+    if (!traced) return true;
+
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        printf("Erreur: impossible d'ecrire la trace %s\n", path);
+        return false;
+    }
+
+    bool first_event = true;
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (int t = 0; t < count; t++) {
+        const Profiler *profiler = profilers[t];
+        if (!profiler->trace) continue;
+
+        long total = profiler->trace_count;
+        long first = total > profiler->trace_capacity ? total - profiler->trace_capacity : 0;
+        for (long i = first; i < total; i++) {
+            const TraceEvent *event = &profiler->trace[i % profiler->trace_capacity];
+            fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    first_event ? "" : ",\n", phase_names[event->phase], t + 1,
+                    event->start / 1000.0, event->duration / 1000.0);
+            first_event = false;
+        }
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
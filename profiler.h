@@ -0,0 +1,59 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Profileur de la boucle principale : durée de chaque phase (événements, ticks,
+// rendu) dans un histogramme glissant, et trace optionnelle au format
+// Chrome trace-event (chrome://tracing, Perfetto) écrite en fin de partie.
+
+#define HISTOGRAM_WINDOW 512     // Nombre de mesures gardées par histogramme
+#define HISTOGRAM_BUCKETS 256    // 8 classes par octave : erreur relative < 12,5 %
+#define TRACE_CAPACITY (1 << 18) // Événements gardés pour la trace (les plus récents)
+
+// Histogramme des dernières HISTOGRAM_WINDOW valeurs (en ns)
+typedef struct Histogram {
+    uint32_t window[HISTOGRAM_WINDOW];   // Valeurs dans l'ordre d'arrivée (anneau)
+    uint16_t buckets[HISTOGRAM_BUCKETS];
+    int count;
+    int next;
+} Histogram;
+
+enum {
+    PHASE_EVENTS,       // handle_events
+    PHASE_UPDATE,       // Enregistrement du tick + update_game
+    PHASE_RENDER,       // render_game complet
+    PHASE_DRAW,         // Dessin des cases (dans render_game)
+    PHASE_PRESENT,      // Copie à l'écran + SDL_RenderPresent (dans render_game)
+    PHASE_COUNT
+};
+
+typedef struct TraceEvent {
+    uint64_t start;     // ns depuis profiler_init
+    uint32_t duration;  // ns
+    int phase;
+} TraceEvent;
+
+typedef struct Profiler {
+    Histogram phases[PHASE_COUNT];
+    bool overlay;               // Barres affichées en jeu (touche F3)
+    uint64_t origin;
+    TraceEvent *trace;          // Anneau des derniers événements, NULL sans --trace
+    int trace_capacity;
+    long trace_count;           // Événements reçus (seuls les trace_capacity derniers sont gardés)
+} Profiler;
+
+void histogram_add(Histogram *histogram, uint32_t value);
+uint32_t histogram_percentile(const Histogram *histogram, double percentile);
+uint32_t histogram_max(const Histogram *histogram);
+
+bool profiler_init(Profiler *profiler, int trace_capacity);
+void profiler_free(Profiler *profiler);
+uint64_t profiler_now(void);
+void profiler_record(Profiler *profiler, int phase, uint64_t start);
+const char *profiler_phase_name(int phase);
+void profiler_print(const Profiler *profiler);
+bool profiler_write_trace(const Profiler *const *profilers, int count, const char *path);
+
+#endif
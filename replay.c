@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "replay.h"
+
+static void write_u32(FILE *file, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        fputc((value >> (8 * i)) & 0xFF, file);
+    }
+}
+
+static void write_u64(FILE *file, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        fputc((int)((value >> (8 * i)) & 0xFF), file);
+    }
+}
+
+static void write_varint(FILE *file, unsigned long value) {
+    while (value >= 0x80) {
+        fputc((int)(value & 0x7F) | 0x80, file);
+        value >>= 7;
+    }
+    fputc((int)value, file);
+}
+
+static bool read_bytes(FILE *file, uint64_t *value, int count) {
+    *value = 0;
+    for (int i = 0; i < count; i++) {
+        int byte = fgetc(file);
+        if (byte == EOF) return false;
+        *value |= (uint64_t)byte << (8 * i);
+    }
+    return true;
+}
+
+static bool read_varint(FILE *file, unsigned long *value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = fgetc(file);
+        if (byte == EOF) return false;
+        *value |= (unsigned long)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// À appeler au début de la partie, avant son premier update_game.
+// Un enregistrement encore ouvert (partie abandonnée) est fermé sans fin de fichier.
+bool replay_open_write(ReplayWriter *writer, const char *path, Game *game) {
+    if (writer->file) {
+        fclose(writer->file);
+    }
+    writer->file = fopen(path, "wb");
+    if (!writer->file) {
+        printf("Erreur: impossible d'ecrire le rejeu %s\n", path);
+        return false;
+    }
+
+    fwrite("SNKR", 1, 4, writer->file);
+    fputc(REPLAY_VERSION, writer->file);
+    fputc(game->difficulty, writer->file);
+    write_u32(writer->file, (uint32_t)game->map.size);
+    write_u64(writer->file, game->seed);
+
+    writer->last_tick = 0;
+    writer->direction = game->snake.direction;
+    return true;
+}
+
+// À appeler juste après chaque update_game : enregistre la direction jouée à ce
+// tick si elle a changé (update_game applique lui-même la file des commandes)
+void replay_record_tick(ReplayWriter *writer, Game *game) {
+    if (!writer->file || game->snake.direction == writer->direction) return;
+
+    long tick = game->ticks - 1;
+    write_varint(writer->file, (unsigned long)(tick - writer->last_tick));
+    fputc(game->snake.direction, writer->file);
+    writer->last_tick = tick;
+    writer->direction = game->snake.direction;
+}
+
+void replay_close_write(ReplayWriter *writer, Game *game) {
+    if (!writer->file) return;
+
+    write_varint(writer->file, (unsigned long)(game->ticks - writer->last_tick));
+    fputc(REPLAY_END, writer->file);
+    write_u32(writer->file, (uint32_t)game->score);
+    fputc(game->won, writer->file);
+
+    fclose(writer->file);
+    writer->file = NULL;
+}
+
+// Rejoue un fichier avec update_game, sans affichage, et compare le score final
+bool replay_run(const char *path, ReplayResult *result) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        printf("Erreur: impossible d'ouvrir le rejeu %s\n", path);
+        return false;
+    }
+
+    char magic[4];
+    int version;
+    uint64_t value;
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, "SNKR", 4) != 0 ||
+        (version = fgetc(file)) != REPLAY_VERSION) {
+        printf("Erreur: %s n'est pas un rejeu valide\n", path);
+        fclose(file);
+        return false;
+    }
+
+    // En-tête vérifié avant toute allocation : taille et difficulté viennent du fichier
+    result->difficulty = fgetc(file);
+    if (result->difficulty == EOF || !read_bytes(file, &value, 4) || !read_bytes(file, &result->seed, 8)) {
+        printf("Erreur: rejeu tronque\n");
+        fclose(file);
+        return false;
+    }
+    if (result->difficulty < 1 || result->difficulty > 3 || value < 8 || value > (uint64_t)max_board_size()) {
+        printf("Erreur: en-tete de rejeu invalide (taille %llu, difficulte %d)\n",
+               (unsigned long long)value, result->difficulty);
+        fclose(file);
+        return false;
+    }
+    result->size = (int)value;
+
+    Game game;
+    if (!init_game(&game, result->size, result->difficulty, result->seed)) {
+        fclose(file);
+        return false;
+    }
+
+    result->complete = false;
+    result->expected_score = -1;
+
+    unsigned long delta;
+    while (game.running && read_varint(file, &delta)) {
+        int direction = fgetc(file);
+        if (direction == EOF) break;
+
+        // Ticks sans changement de direction jusqu'au prochain enregistrement
+        for (unsigned long t = 0; t < delta && game.running; t++) {
+            update_game(&game);
+        }
+
+        if (direction == REPLAY_END) {
+            if (read_bytes(file, &value, 4)) {
+                result->expected_score = (int)value;
+                result->complete = true;
+            }
+            break;
+        }
+        change_direction(&game.snake, direction);
+    }
+
+    result->ticks = game.ticks;
+    result->score = game.score;
+
+    free_game(&game);
+    fclose(file);
+    return true;
+}
+
+// Mode --replay : rejoue le fichier, affiche le résultat et vérifie le score
+bool replay_verify(const char *path) {
+    ReplayResult result;
+    if (!replay_run(path, &result)) {
+        return false;
+    }
+
+    printf("Rejeu %s : map %dx%d, difficulte %d, graine %llu\n", path, result.size, result.size,
+           result.difficulty, (unsigned long long)result.seed);
+    printf("%ld ticks rejoues, score %d\n", result.ticks, result.score);
+
+    if (!result.complete) {
+        printf("Rejeu incomplet : score final non enregistre\n");
+        return false;
+    }
+    if (result.score != result.expected_score) {
+        printf("ECHEC : score attendu %d\n", result.expected_score);
+        return false;
+    }
+    printf("OK : score identique a la partie enregistree\n");
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdio.h>
+#include "game.h"
+
+// Format binaire de rejeu (entiers en little-endian) :
+//   en-tête : "SNKR", version (1 octet), difficulté (1 octet), taille (4 octets), graine (8 octets)
+//   puis une suite d'enregistrements : écart en ticks (varint) + direction (1 octet),
+//   écrits seulement quand la direction change.
+//   fin : écart jusqu'au dernier tick (varint) + REPLAY_END, score final (4 octets), victoire (1 octet)
+// Le fichier est lu et écrit au fil de l'eau : rien n'est gardé en mémoire.
+
+#define REPLAY_VERSION 2   // 2 : tirage des cases libres dans l'ordre des indices
+#define REPLAY_END 0xFF
+
+typedef struct ReplayWriter {
+    FILE *file;
+    long last_tick;     // Tick du dernier enregistrement
+    int direction;      // Dernière direction enregistrée
+} ReplayWriter;
+
+typedef struct ReplayResult {
+    uint64_t seed;
+    int size;
+    int difficulty;
+    long ticks;
+    int score;
+    int expected_score;
+    bool complete;      // Fin de fichier présente (sinon partie interrompue)
+} ReplayResult;
+
+bool replay_open_write(ReplayWriter *writer, const char *path, Game *game);
+void replay_record_tick(ReplayWriter *writer, Game *game);
+void replay_close_write(ReplayWriter *writer, Game *game);
+bool replay_run(const char *path, ReplayResult *result);
+bool replay_verify(const char *path);
+
+#endif
@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "runner.h"
+#include "batch.h"
+
+// Nombre visé de paquets par thread : assez pour que le vol équilibre la fin
+#define TASKS_PER_THREAD 16
+
+// File de paquets d'un thread : intervalle [front, back) empaqueté dans un
+// seul mot 64 bits pour être modifié par compare-and-swap. Le propriétaire
+// prend à l'avant, les voleurs prennent à l'arrière.
+typedef struct WorkQueue {
+    uint64_t range;
+    char padding[56];   // Une ligne de cache par file
+} WorkQueue;
+
+typedef struct Worker {
+    pthread_t thread;
+    int id;
+    struct Runner *runner;
+    RunnerStats stats;  // Écrit une seule fois, à la fin du thread
+} Worker;
+
+typedef struct Runner {
+    const RunnerConfig *config;
+    Batch batch;
+    int chunk;          // Parties par paquet
+    int task_count;
+    long *quota;        // Parties à terminer par emplacement
+    WorkQueue *queues;
+    Worker *workers;
+} Runner;
+
+static uint64_t pack_range(uint32_t front, uint32_t back) {
+    return ((uint64_t)front << 32) | back;
+}
+
+static bool take_task(WorkQueue *queue, bool from_back, int *task) {
+    uint64_t range = __atomic_load_n(&queue->range, __ATOMIC_ACQUIRE);
+
+    for (;;) {
+        uint32_t front = (uint32_t)(range >> 32);
+        uint32_t back = (uint32_t)range;
+        if (front >= back) return false;
+
+        uint64_t next = from_back ? pack_range(front, back - 1) : pack_range(front + 1, back);
+        if (__atomic_compare_exchange_n(&queue->range, &range, next, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *task = from_back ? (int)(back - 1) : (int)front;
+            return true;
+        }
+    }
+}
+
+// Joue toutes les parties d'un paquet jusqu'à épuisement de leur quota,
+// en relançant les parties terminées sur place. Une partie où le joueur tourne
+// en rond est arrêtée pour consommer le quota, mais n'entre pas dans les moyennes :
+// seules les parties finies par update_game y comptent.
+static void run_task(Runner *runner, int task, RunnerStats *stats) {
+    const RunnerConfig *config = runner->config;
+    int first = task * runner->chunk;
+    int last = first + runner->chunk;
+    if (last > config->games) last = config->games;
+
+    // Sans fruit mangé pendant size * size ticks, le joueur tourne en rond
+    int stall_limit = config->size * config->size;
+
+    for (int i = first; i < last; i++) {
+        Game *game = &runner->batch.games[i];
+        long remaining = runner->quota[i];
+        int idle = 0;
+        int last_score = game->score;
+
+        while (remaining > 0) {
+            change_direction(&game->snake, config->policy(game));
+            update_game(game);
+            stats->steps++;
+
+            bool stalled = false;
+            if (game->score != last_score) {
+                last_score = game->score;
+                idle = 0;
+            } else if (game->running && ++idle > stall_limit) {
+                stalled = true;
+                stats->stalled++;
+            }
+
+            if (!game->running) {
+                stats->episodes++;
+                stats->total_score += game->score;
+                stats->total_length += game->snake.length;
+                if (game->score > stats->best_score) stats->best_score = game->score;
+            }
+            if (!game->running || stalled) {
+                seed_game(game, next_game_seed(game));
+                reset_game(game);
+                remaining--;
+                idle = 0;
+                last_score = game->score;
+            }
+        }
+    }
+}
+
+static void *worker_main(void *arg) {
+    Worker *worker = arg;
+    Runner *runner = worker->runner;
+    int threads = runner->config->threads;
+    int task;
+
+    // Compteurs sur la pile du thread : ceux des Worker voisins partagent des
+    // lignes de cache, ils ne sont écrits qu'une fois à la fin
+    RunnerStats stats = {0, 0, 0, 0, 0, 0};
+
+    for (;;) {
+        if (take_task(&runner->queues[worker->id], false, &task)) {
+            run_task(runner, task, &stats);
+            continue;
+        }
+
+        // File vide : vol d'un paquet chez les autres threads
+        bool stolen = false;
+        for (int k = 1; k < threads && !stolen; k++) {
+            WorkQueue *victim = &runner->queues[(worker->id + k) % threads];
+            stolen = take_task(victim, true, &task);
+        }
+        if (!stolen) break;
+        run_task(runner, task, &stats);
+    }
+
+    worker->stats = stats;
+    return NULL;
+}
+
+// false si la mémoire manque ou si un thread ne peut pas être lancé (tout est
+// alors rendu, et les threads déjà lancés attendus)
+bool run_parallel(const RunnerConfig *config, RunnerStats *stats) {
+    Runner runner;
+    int threads = config->threads;
+
+    runner.config = config;
+    if (!create_batch(&runner.batch, config->games, config->size, config->difficulty, config->seed)) {
+        return false;
+    }
+
+    runner.chunk = config->games / (threads * TASKS_PER_THREAD);
+    if (runner.chunk < 1) runner.chunk = 1;
+    runner.task_count = (config->games + runner.chunk - 1) / runner.chunk;
+
+    runner.quota = malloc(config->games * sizeof(long));
+    runner.queues = calloc(threads, sizeof(WorkQueue));
+    runner.workers = calloc(threads, sizeof(Worker));
+    if (!runner.quota || !runner.queues || !runner.workers) {
+        printf("Erreur: memoire insuffisante pour %d threads et %d parties\n", threads, config->games);
+        free(runner.quota);
+        free(runner.queues);
+        free(runner.workers);
+        free_batch(&runner.batch);
+        return false;
+    }
+
+    for (int i = 0; i < config->games; i++) {
+        runner.quota[i] = config->episodes / config->games +
+                          (i < config->episodes % config->games ? 1 : 0);
+    }
+
+    // Répartition initiale des paquets en tranches contiguës
+    for (int t = 0; t < threads; t++) {
+        uint32_t front = (uint32_t)((long)runner.task_count * t / threads);
+        uint32_t back = (uint32_t)((long)runner.task_count * (t + 1) / threads);
+        runner.queues[t].range = pack_range(front, back);
+    }
+
+    int started = 0;
+    for (; started < threads; started++) {
+        runner.workers[started].id = started;
+        runner.workers[started].runner = &runner;
+        if (pthread_create(&runner.workers[started].thread, NULL, worker_main, &runner.workers[started]) != 0) {
+            printf("Erreur: impossible de lancer le thread %d sur %d\n", started + 1, threads);
+            break;
+        }
+    }
+
+    // Échec d'un lancement : les files sont vidées, les threads déjà lancés
+    // s'arrêtent après leur paquet en cours
+    if (started < threads) {
+        for (int t = 0; t < threads; t++) {
+            __atomic_store_n(&runner.queues[t].range, pack_range(0, 0), __ATOMIC_RELEASE);
+        }
+    }
+
+    stats->episodes = 0;
+    stats->steps = 0;
+    stats->total_score = 0;
+    stats->total_length = 0;
+    stats->best_score = 0;
+    stats->stalled = 0;
+
+    for (int t = 0; t < started; t++) {
+        RunnerStats *local = &runner.workers[t].stats;
+        pthread_join(runner.workers[t].thread, NULL);
+
+        stats->episodes += local->episodes;
+        stats->steps += local->steps;
+        stats->total_score += local->total_score;
+        stats->total_length += local->total_length;
+        if (local->best_score > stats->best_score) stats->best_score = local->best_score;
+        stats->stalled += local->stalled;
+    }
+
+    free(runner.quota);
+    free(runner.queues);
+    free(runner.workers);
+    free_batch(&runner.batch);
+    return started == threads;
+}
@@ -0,0 +1,35 @@
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include "game.h"
+
+// Exécution parallèle de nombreuses parties sur plusieurs threads.
+// Les parties sont réparties en paquets ; chaque thread vide sa propre file
+// puis vole les paquets restants des autres threads (vol de travail), car
+// les parties ne meurent pas toutes au même moment.
+
+// Joueur automatique : retourne la direction à prendre pour le prochain tick
+typedef int (*Policy)(Game *game);
+
+typedef struct RunnerConfig {
+    int threads;
+    int games;          // Parties simultanées
+    int size;
+    int difficulty;
+    long episodes;      // Nombre total de parties à jouer (terminées ou arrêtées)
+    uint64_t seed;      // Graine du lot (voir create_batch)
+    Policy policy;
+} RunnerConfig;
+
+typedef struct RunnerStats {
+    long episodes;      // Parties finies par update_game, seules comptées dans les totaux
+    long steps;
+    long total_score;
+    long total_length;
+    int best_score;
+    long stalled;       // Parties arrêtées faute de progrès (joueur bloqué dans une boucle), hors totaux
+} RunnerStats;
+
+bool run_parallel(const RunnerConfig *config, RunnerStats *stats);
+
+#endif
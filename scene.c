@@ -0,0 +1,80 @@
+#include "scene.h"
+
+// La partie n'est pas encore lancée : on démarre dans le menu
+void init_scenes(Scenes *scenes, Game *game, SceneHooks hooks) {
+    scenes->scene = SCENE_MENU;
+    scenes->game = game;
+    scenes->hooks = hooks;
+}
+
+// Seul point de changement de scène. La partie n'avance que dans la scène de
+// jeu ; ailleurs elle est arrêtée et Game appartient à l'appelant.
+void set_scene(Scenes *scenes, Scene scene) {
+    if (scene == scenes->scene) return;
+    if (scenes->scene == SCENE_PLAYING) {
+        scenes->hooks.stop(scenes->hooks.context);
+    }
+    scenes->scene = scene;
+    scenes->hooks.entered(scenes->hooks.context, scene);
+    if (scene == SCENE_PLAYING) {
+        scenes->hooks.resume(scenes->hooks.context);
+    }
+}
+
+// Lance la partie choisie dans le menu : taille et vitesse selon la difficulté.
+// La zone de la partie est réservée au démarrage, pas d'allocation ici ; si
+// elle manque quand même, on quitte (retourne false).
+bool scene_start_game(Scenes *scenes, int option) {
+    Game *game = scenes->game;
+    int size;
+    switch (option) {
+        case 0:
+            size = 15;
+            game->game_speed = 200; // Facile = lent
+            break;
+        case 1:
+            size = 20;
+            game->game_speed = 150; // Moyen = normal
+            break;
+        case 2:
+            size = MENU_MAX_SIZE;
+            game->game_speed = 100; // Difficile = rapide
+            break;
+        default:
+            size = 20;
+            game->game_speed = 150;
+            break;
+    }
+    if (game->board_size > 0) size = game->board_size;
+    if (!restart_game(game, size, option + 1, game->seed)) {
+        set_scene(scenes, SCENE_QUIT);
+        return false;
+    }
+    scenes->hooks.restarted(scenes->hooks.context);
+    set_scene(scenes, SCENE_PLAYING);
+    return true;
+}
+
+// Touche P : pause ou reprise, sauf après une défaite
+void scene_toggle_pause(Scenes *scenes) {
+    if (scenes->scene == SCENE_PLAYING) {
+        set_scene(scenes, SCENE_PAUSED);
+    } else if (scenes->scene == SCENE_PAUSED) {
+        set_scene(scenes, SCENE_PLAYING);
+    }
+}
+
+// ESPACE après une défaite : nouvelle partie de même taille et difficulté, dans la même mémoire
+void scene_replay(Scenes *scenes) {
+    if (scenes->scene != SCENE_GAME_OVER) return;
+    seed_game(scenes->game, next_game_seed(scenes->game));
+    reset_game(scenes->game);
+    scenes->hooks.restarted(scenes->hooks.context);
+    set_scene(scenes, SCENE_PLAYING);
+}
+
+// Touche M : la partie est arrêtée avant de tirer la graine de la suivante
+void scene_back_to_menu(Scenes *scenes) {
+    set_scene(scenes, SCENE_MENU);
+    scenes->game->seed = next_game_seed(scenes->game);
+}
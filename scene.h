@@ -0,0 +1,45 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <stdbool.h>
+#include "game.h"
+
+// Enchaînement des scènes de la version interactive, sans SDL : snake le pilote
+// avec la fenêtre et le thread de simulation, snake_headless --soak avec des
+// crochets qui jouent les ticks eux-mêmes. Les effets propres à chaque version
+// (arrêt et reprise de la simulation, titre de la fenêtre, image à refaire)
+// passent par les crochets.
+
+#define MENU_OPTIONS 3     // Facile, moyen, difficile (voir scene_start_game)
+#define MENU_MAX_SIZE 25   // Plus grande map proposée par le menu (difficile)
+
+typedef enum Scene {
+    SCENE_MENU,
+    SCENE_PLAYING,
+    SCENE_PAUSED,
+    SCENE_GAME_OVER,    // Dernière image figée : ESPACE rejoue, M revient au menu
+    SCENE_QUIT
+} Scene;
+
+typedef struct SceneHooks {
+    void (*stop)(void *context);                // Sortie de la scène de jeu : la partie n'avance plus
+    void (*resume)(void *context);              // Entrée dans la scène de jeu
+    void (*entered)(void *context, Scene scene);
+    void (*restarted)(void *context);           // Nouvelle partie : toute la map a changé
+    void *context;
+} SceneHooks;
+
+typedef struct Scenes {
+    Scene scene;        // Changée seulement par set_scene
+    Game *game;         // N'appartient à l'appelant qu'en dehors de la scène de jeu
+    SceneHooks hooks;
+} Scenes;
+
+void init_scenes(Scenes *scenes, Game *game, SceneHooks hooks);
+void set_scene(Scenes *scenes, Scene scene);
+bool scene_start_game(Scenes *scenes, int option);
+void scene_toggle_pause(Scenes *scenes);
+void scene_replay(Scenes *scenes);
+void scene_back_to_menu(Scenes *scenes);
+
+#endif
@@ -0,0 +1,33 @@
+#include "scheduler.h"
+
+// Repart d'une grille neuve (nouvelle partie, retour du menu) ; les compteurs sont conservés
+void scheduler_start(TickScheduler *scheduler, uint64_t now, uint64_t frequency, int period_ms) {
+    scheduler->frequency = frequency;
+    scheduler->period = frequency * (uint64_t)period_ms / 1000;
+    if (scheduler->period == 0) scheduler->period = 1;
+    scheduler->next_tick = now + scheduler->period;
+}
+
+// Nombre de ticks à exécuter maintenant ; avance l'échéance d'autant
+int scheduler_due_ticks(TickScheduler *scheduler, uint64_t now) {
+    if (now < scheduler->next_tick) return 0;
+
+    uint64_t due = (now - scheduler->next_tick) / scheduler->period + 1;
+    scheduler->next_tick += due * scheduler->period;
+
+    if (due > MAX_CATCHUP_TICKS) {
+        scheduler->dropped_ticks += (long)(due - MAX_CATCHUP_TICKS);
+        due = MAX_CATCHUP_TICKS;
+    }
+    scheduler->late_ticks += (long)(due - 1);
+    scheduler->ticks += (long)due;
+    return (int)due;
+}
+
+// Temps d'attente jusqu'au prochain tick, arrondi à la milliseconde supérieure
+int scheduler_wait_ms(const TickScheduler *scheduler, uint64_t now) {
+    if (now >= scheduler->next_tick) return 0;
+
+    uint64_t remaining = scheduler->next_tick - now;
+    return (int)((remaining * 1000 + scheduler->frequency - 1) / scheduler->frequency);
+}
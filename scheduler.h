@@ -0,0 +1,25 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+// Cadenceur à pas fixe : les ticks tombent sur une grille régulière
+// (next_tick += period) mesurée avec un compteur haute résolution,
+// au lieu de dériver de la durée de chaque tour de boucle.
+
+#define MAX_CATCHUP_TICKS 3   // Au-delà, les ticks en retard sont abandonnés
+
+typedef struct TickScheduler {
+    uint64_t frequency;     // Unités du compteur par seconde
+    uint64_t period;        // Durée d'un tick en unités du compteur
+    uint64_t next_tick;     // Échéance du prochain tick
+    long ticks;             // Ticks exécutés
+    long late_ticks;        // Ticks exécutés avec au moins une période de retard
+    long dropped_ticks;     // Ticks abandonnés (retard supérieur à MAX_CATCHUP_TICKS)
+} TickScheduler;
+
+void scheduler_start(TickScheduler *scheduler, uint64_t now, uint64_t frequency, int period_ms);
+int scheduler_due_ticks(TickScheduler *scheduler, uint64_t now);
+int scheduler_wait_ms(const TickScheduler *scheduler, uint64_t now);
+
+#endif
@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "simulation.h"
+
+// Nouvelle image pour le thread d'affichage ; un seul événement SDL en attente
+// à la fois, l'affichage prend toujours la plus récente
+static void publish(Simulation *simulation) {
+    Snapshot *snapshot = capture_snapshot(&simulation->snapshots, simulation->game, &simulation->camera,
+                                          simulation->width, simulation->height);
+    const Histogram *update = &simulation->profiler.phases[PHASE_UPDATE];
+    snapshot->update_ns[0] = histogram_percentile(update, 50);
+    snapshot->update_ns[1] = histogram_percentile(update, 99);
+    snapshot->update_ns[2] = histogram_max(update);
+    publish_snapshot(&simulation->snapshots);
+
+    if (!__atomic_exchange_n(&simulation->notified, 1, __ATOMIC_ACQ_REL)) {
+        SDL_Event event;
+        memset(&event, 0, sizeof(event));
+        event.type = simulation->snapshot_event;
+        SDL_PushEvent(&event);
+    }
+}
+
+// Ticks arrivés à échéance ; retourne le nombre de ticks joués
+static int run_ticks(Simulation *simulation) {
+    Game *game = simulation->game;
+    int due = scheduler_due_ticks(&simulation->scheduler, SDL_GetPerformanceCounter());
+    int played = 0;
+
+    for (; played < due && game->running; played++) {
+        uint64_t start = profiler_now();
+        if (game->ticks == 0) {
+            replay_open_write(&simulation->recorder, simulation->record_path, game);
+        }
+        if (simulation->use_ai) {
+            change_direction(&game->snake, ai_decide(&simulation->ai, game));
+        } else if (simulation->use_hamilton) {
+            change_direction(&game->snake, hamilton_decide(&simulation->hamilton, game));
+        }
+        update_game(game);
+        replay_record_tick(&simulation->recorder, game);
+        if (simulation->use_hamilton && game->running && hamilton_stalled(&simulation->hamilton, game)) {
+            game->running = false;   // Map sans circuit : arrêtée comme une défaite
+        }
+        if (game->input_time > 0) {
+            uint64_t latency = profiler_now() - game->input_time;
+            histogram_add(&simulation->input_latency, latency > UINT32_MAX ? UINT32_MAX : (uint32_t)latency);
+        }
+        profiler_record(&simulation->profiler, PHASE_UPDATE, start);
+    }
+
+    if (played > 0 && !game->running) {
+        replay_close_write(&simulation->recorder, game);
+    }
+    return played;
+}
+
+static int simulation_thread(void *data) {
+    Simulation *simulation = data;
+
+    SDL_LockMutex(simulation->lock);
+    while (simulation->state != SIMULATION_EXIT) {
+        if (simulation->state == SIMULATION_STOPPED) {
+            simulation->stopped = true;
+            SDL_CondBroadcast(simulation->changed);
+            SDL_CondWait(simulation->changed, simulation->lock);
+            continue;
+        }
+        if (simulation->stopped) {
+            // Reprise (nouvelle partie ou fin de pause) : la grille des ticks repart de maintenant
+            simulation->stopped = false;
+            scheduler_start(&simulation->scheduler, SDL_GetPerformanceCounter(),
+                            SDL_GetPerformanceFrequency(), simulation->game->game_speed);
+        }
+
+        // Attente du prochain tick, interrompue par un changement d'état
+        int wait = scheduler_wait_ms(&simulation->scheduler, SDL_GetPerformanceCounter());
+        if (wait > 0) {
+            SDL_CondWaitTimeout(simulation->changed, simulation->lock, wait);
+            continue;
+        }
+
+        SDL_UnlockMutex(simulation->lock);
+        int played = run_ticks(simulation);
+        SDL_LockMutex(simulation->lock);
+
+        // Partie finie : arrêt avant publication, pour que l'affichage qui voit
+        // l'image finale puisse relancer sans course avec cet arrêt
+        if (!simulation->game->running && simulation->state == SIMULATION_RUNNING) {
+            simulation->state = SIMULATION_STOPPED;
+        }
+        if (played > 0) {
+            publish(simulation);
+        }
+    }
+    simulation->stopped = true;
+    SDL_CondBroadcast(simulation->changed);
+    SDL_UnlockMutex(simulation->lock);
+    return 0;
+}
+
+// Le thread démarre à l'arrêt : game n'a pas encore de partie
+bool create_simulation(Simulation *simulation, Game *game, int width, int height, int trace_capacity) {
+    memset(simulation, 0, sizeof(*simulation));
+    simulation->game = game;
+    simulation->width = width;
+    simulation->height = height;
+    simulation->state = SIMULATION_STOPPED;
+    init_ai(&simulation->ai);
+    init_hamilton(&simulation->hamilton);
+
+    int cells = (width / MIN_CELL_SIZE) * (height / MIN_CELL_SIZE);
+    if (!create_triple_buffer(&simulation->snapshots, cells)) {
+        return false;
+    }
+    if (!profiler_init(&simulation->profiler, trace_capacity)) {
+        free_triple_buffer(&simulation->snapshots);
+        return false;
+    }
+
+    simulation->snapshot_event = SDL_RegisterEvents(1);
+    simulation->lock = SDL_CreateMutex();
+    simulation->changed = SDL_CreateCond();
+    if (simulation->snapshot_event == (Uint32)-1 || !simulation->lock || !simulation->changed ||
+        !(simulation->thread = SDL_CreateThread(simulation_thread, "simulation", simulation))) {
+        printf("Erreur thread de simulation: %s\n", SDL_GetError());
+        if (simulation->changed) SDL_DestroyCond(simulation->changed);
+        if (simulation->lock) SDL_DestroyMutex(simulation->lock);
+        profiler_free(&simulation->profiler);
+        free_triple_buffer(&simulation->snapshots);
+        return false;
+    }
+    return true;
+}
+
+void free_simulation(Simulation *simulation) {
+    SDL_LockMutex(simulation->lock);
+    simulation->state = SIMULATION_EXIT;
+    SDL_CondBroadcast(simulation->changed);
+    SDL_UnlockMutex(simulation->lock);
+    SDL_WaitThread(simulation->thread, NULL);
+
+    SDL_DestroyCond(simulation->changed);
+    SDL_DestroyMutex(simulation->lock);
+    free_ai(&simulation->ai);
+    free_hamilton(&simulation->hamilton);
+    profiler_free(&simulation->profiler);
+    free_triple_buffer(&simulation->snapshots);
+}
+
+// Retourne quand le thread de simulation est à l'arrêt : Game et l'enregistrement
+// appartiennent alors au thread appelant
+void stop_simulation(Simulation *simulation) {
+    SDL_LockMutex(simulation->lock);
+    if (simulation->state == SIMULATION_RUNNING) {
+        simulation->state = SIMULATION_STOPPED;
+        SDL_CondBroadcast(simulation->changed);
+    }
+    while (!simulation->stopped) {
+        SDL_CondWait(simulation->changed, simulation->lock);
+    }
+    SDL_UnlockMutex(simulation->lock);
+}
+
+// Publie l'état courant (nouvelle partie : l'affichage n'attend pas le premier
+// tick) puis relance les ticks
+void resume_simulation(Simulation *simulation) {
+    SDL_LockMutex(simulation->lock);
+    while (!simulation->stopped) {
+        SDL_CondWait(simulation->changed, simulation->lock);
+    }
+    publish(simulation);
+    if (simulation->game->running) {
+        simulation->state = SIMULATION_RUNNING;
+        SDL_CondBroadcast(simulation->changed);
+    }
+    SDL_UnlockMutex(simulation->lock);
+}
+
+// Dernière image publiée, valable jusqu'à l'appel suivant
+const Snapshot *simulation_snapshot(Simulation *simulation, bool *fresh) {
+    __atomic_store_n(&simulation->notified, 0, __ATOMIC_RELEASE);
+    return latest_snapshot(&simulation->snapshots, fresh);
+}
@@ -0,0 +1,61 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "game.h"
+#include "ai.h"
+#include "hamilton.h"
+#include "replay.h"
+#include "scheduler.h"
+#include "snapshot.h"
+#include "profiler.h"
+
+// Thread de simulation de la version SDL : update_game à pas fixe, sans attendre
+// l'affichage. Chaque groupe de ticks est publié dans un triple tampon
+// d'images (snapshot.h) et signalé au thread d'affichage par un événement SDL.
+// Les directions arrivent par la file de la partie (input.h).
+// Le thread d'affichage ne touche Game qu'entre stop_simulation et
+// resume_simulation, pendant que le thread de simulation est à l'arrêt.
+
+typedef enum SimulationState {
+    SIMULATION_STOPPED,
+    SIMULATION_RUNNING,
+    SIMULATION_EXIT
+} SimulationState;
+
+typedef struct Simulation {
+    Game *game;
+    bool use_ai;
+    bool use_hamilton;
+    Ai ai;
+    Hamilton hamilton;
+    const char *record_path;
+    ReplayWriter recorder;          // Chaque partie est enregistrée (la dernière écrase la précédente)
+    TickScheduler scheduler;
+    Profiler profiler;              // PHASE_UPDATE, mesurée dans ce thread
+    Histogram input_latency;        // Appui sur une flèche -> tick qui l'applique (ns)
+
+    // Images publiées
+    TripleBuffer snapshots;
+    Viewport camera;
+    int width;                      // Taille de la fenêtre en pixels
+    int height;
+    Uint32 snapshot_event;          // Type de l'événement SDL d'une nouvelle image
+    int notified;                   // Événement en attente (accès atomiques)
+
+    // Contrôle du thread : state est demandé sous lock, stopped confirmé sous lock
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_cond *changed;
+    SimulationState state;
+    bool stopped;
+} Simulation;
+
+bool create_simulation(Simulation *simulation, Game *game, int width, int height, int trace_capacity);
+void free_simulation(Simulation *simulation);
+void stop_simulation(Simulation *simulation);
+void resume_simulation(Simulation *simulation);
+const Snapshot *simulation_snapshot(Simulation *simulation, bool *fresh);
+
+#endif
@@ -1,76 +1,180 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include "snake.h"
 #include "game.h"
 #include "graphics.h"
+#include "replay.h"
+#include "simulation.h"
+
+// Délai entre l'appui sur une flèche et le tick qui déplace la tête dans cette
+// direction, pour régler game_speed et l'attente de la boucle
+static void print_input_latency(const Simulation *simulation) {
+    const Histogram *latency = &simulation->input_latency;
+    if (latency->count == 0) return;
+    printf("Latence touche -> mouvement (%d derniers appuis): p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms\n",
+           latency->count,
+           histogram_percentile(latency, 50) / 1e6,
+           histogram_percentile(latency, 90) / 1e6,
+           histogram_percentile(latency, 99) / 1e6,
+           histogram_max(latency) / 1e6);
+}
 
 int main(int argc, char *argv[]) {
-    // Éviter les warnings pour paramètres non utilisés
-    (void)argc;
-    (void)argv;
-    
-    srand(time(NULL));
-    
     Game game;
+    Display display;
+    
+    // Graine de la première partie : --seed N pour rejouer une partie, sinon l'heure
+    game.seed = (uint64_t)time(NULL);
+    const char *record_path = "snake_replay.rpl";
+    bool software = false;
+    const char *trace_path = NULL;
+    bool use_ai = false;
+    bool use_hamilton = false;
+    game.board_size = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            game.seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            // Taille de map libre ; au-delà de la fenêtre, la caméra suit la tête
+            game.board_size = atoi(argv[++i]);
+            if (game.board_size < 8 || game.board_size > max_board_size()) {
+                printf("Taille de map invalide (entre 8 et %d)\n", max_board_size());
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--ai") == 0) {
+            // Le serpent est dirigé par l'IA, les flèches ne servent plus qu'au menu
+            use_ai = true;
+        } else if (strcmp(argv[i], "--hamilton") == 0) {
+            // Joueur sur cycle hamiltonien (parties longues)
+            use_hamilton = true;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--software") == 0) {
+            software = true;
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            // Rejeu sans affichage, à vitesse maximale
+            return replay_verify(argv[++i]) ? 0 : 1;
+        }
+    }
     
     // Initialisation minimale pour le menu
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        printf("Erreur SDL: %s\n", SDL_GetError());
+    if (!init_display(&display, software)) {
         return 1;
     }
-    
-    game.window = SDL_CreateWindow(
-        "Snake Game - Menu",
-        SDL_WINDOWPOS_CENTERED,
-        SDL_WINDOWPOS_CENTERED,
-        WINDOW_SIZE,
-        WINDOW_SIZE,
-        SDL_WINDOW_SHOWN
-    );
-    
-    if (!game.window) {
-        printf("Erreur fenêtre: %s\n", SDL_GetError());
-        SDL_Quit();
+    if (!profiler_init(&display.profiler, trace_path ? TRACE_CAPACITY : 0)) {
+        free_display(&display);
         return 1;
     }
+    display.autopilot = use_ai || use_hamilton;
     
-    game.renderer = SDL_CreateRenderer(game.window, -1, SDL_RENDERER_ACCELERATED);
-    if (!game.renderer) {
-        printf("Erreur renderer: %s\n", SDL_GetError());
-        SDL_DestroyWindow(game.window);
-        SDL_Quit();
+    // Mémoire de la plus grande partie possible, réservée une fois : démarrer
+    // ou relancer une partie depuis le menu ne fait que la réinitialiser
+    game.arena = (Arena){0};
+    game.input = (InputQueue){0};
+    if (!reserve_game(&game, game.board_size > 0 ? game.board_size : MENU_MAX_SIZE)) {
+        profiler_free(&display.profiler);
+        free_display(&display);
         return 1;
     }
     
-    game.running = true;
-    game.in_menu = true;
+    game.running = false;
+    game.score = 0;
+    game.won = false;
     game.game_speed = 150; // Valeur par défaut
     
-    // Afficher le menu au démarrage
-    show_menu(&game);
+    // Les ticks tournent dans leur propre thread ; celui-ci ne fait qu'afficher
+    Simulation simulation;
+    if (!create_simulation(&simulation, &game, WINDOW_SIZE, WINDOW_SIZE, trace_path ? TRACE_CAPACITY : 0)) {
+        free_game(&game);
+        profiler_free(&display.profiler);
+        free_display(&display);
+        return 1;
+    }
+    simulation.use_ai = use_ai;
+    simulation.use_hamilton = use_hamilton;
+    simulation.record_path = record_path;
+    simulation.profiler.origin = display.profiler.origin;
+    attach_scenes(&display, &game, &simulation);
     
-    Uint32 last_update = SDL_GetTicks();
+    // Une seule boucle pour toutes les scènes : on attend un événement (touche ou
+    // nouvelle image de la simulation) et on ne redessine que si l'état a changé
+    Scene entered = SCENE_QUIT;
+    bool redraw = false;
     
-    while (game.running) {
-        Uint32 current_time = SDL_GetTicks();
+    while (display.scenes.scene != SCENE_QUIT) {
+        // Entrée dans une scène : l'image est à refaire
+        if (display.scenes.scene != entered) {
+            entered = display.scenes.scene;
+            redraw = true;
+        }
         
-        handle_events(&game);
+        if (!redraw) {
+            SDL_WaitEventTimeout(NULL, MENU_WAIT_MS);
+        }
         
-        if (!game.in_menu && (int)(current_time - last_update) > game.game_speed) {
-            update_game(&game);
-            last_update = current_time;
+        uint64_t start = profiler_now();
+        bool changed = handle_events(&display, &game) || redraw;
+        profiler_record(&display.profiler, PHASE_EVENTS, start);
+        redraw = false;
+        
+        if (display.scenes.scene != entered) {
+            // Partie quittée en cours (menu ou ECHAP) : l'enregistrement est clos
+            if (display.scenes.scene == SCENE_MENU || display.scenes.scene == SCENE_QUIT) {
+                replay_close_write(&simulation.recorder, &game);
+            }
+            continue;
         }
         
-        if (!game.in_menu) {
-            render_game(&game);
+        if (display.scenes.scene == SCENE_MENU) {
+            if (changed) {
+                start = profiler_now();
+                draw_menu(&display, &display.menu);
+                profiler_record(&display.profiler, PHASE_RENDER, start);
+            }
+            continue;
         }
         
-        SDL_Delay(10);
+        bool fresh;
+        const Snapshot *snapshot = simulation_snapshot(&simulation, &fresh);
+        if (fresh || changed) {
+            start = profiler_now();
+            render_game(&display, snapshot);
+            profiler_record(&display.profiler, PHASE_RENDER, start);
+        }
+        if (fresh && display.scenes.scene == SCENE_PLAYING && !snapshot->running) {
+            set_scene(&display.scenes, SCENE_GAME_OVER);
+            printf("Partie terminee (graine %llu), score: %d\n", (unsigned long long)game.seed, game.score);
+        }
     }
     
+    stop_simulation(&simulation);
+    TickScheduler *scheduler = &simulation.scheduler;
+    if (scheduler->ticks > 0) {
+        printf("Ticks: %ld, en retard: %ld, abandonnes: %ld\n",
+               scheduler->ticks, scheduler->late_ticks, scheduler->dropped_ticks);
+    }
+    profiler_print(&display.profiler);
+    profiler_print(&simulation.profiler);
+    print_input_latency(&simulation);
+    ai_print_stats(&simulation.ai);
+    const Profiler *profilers[2] = {&display.profiler, &simulation.profiler};
+    if (trace_path && profiler_write_trace(profilers, 2, trace_path)) {
+        printf("Trace ecrite dans %s\n", trace_path);
+    }
+    profiler_free(&display.profiler);
+    replay_close_write(&simulation.recorder, &game);
+    free_simulation(&simulation);
+    printf("Graine de la partie: %llu\n", (unsigned long long)game.seed);
+    if (game.won) {
+        printf("Victoire ! Le serpent remplit le plateau.\n");
+    }
     printf("Game Over! Score final: %d\n", game.score);
     free_game(&game);
+    free_display(&display);
     
     return 0;
-}
\ No newline at end of file
+}
@@ -3,73 +3,66 @@
 
 #include <SDL2/SDL.h>
 #include <stdbool.h>
+#include "game.h"
+#include "framebuffer.h"
+#include "profiler.h"
+#include "simulation.h"
+#include "scene.h"
 
 #define WINDOW_SIZE 600
-#define MAX_OBSTACLES 20
 
-// Structures
-typedef struct Point {
-    int x;
-    int y;
-} Point;
+#define MENU_WAIT_MS 500   // Attente maximale d'un événement dans le menu
 
-typedef struct Node {
-    Point position;
-    struct Node *next;
-} Node;
+// Menu de départ : états de la machine et sélection courante
+typedef enum MenuState {
+    MENU_OPEN,      // Choix en cours
+    MENU_START,     // Partie choisie
+    MENU_QUIT
+} MenuState;
 
-typedef struct Snake {
-    Node *head;
-    Node *tail;
-    int direction;
-    int length;
-} Snake;
+typedef struct Menu {
+    int selected;
+    int printed;    // Option affichée dans la console (-1 : rien d'affiché)
+} Menu;
 
-typedef struct GameMap {
-    char **grid;
-    int size;
-    Point fruit;
-    Point special_fruit;
-    int obstacles_count;
-    int special_fruit_timer;
-} GameMap;
-
-typedef struct Game {
-    Snake snake;
-    GameMap map;
-    bool running;
-    bool in_menu;
-    int score;
-    int difficulty;
-    int game_speed;
+// Contexte SDL de la version interactive (la logique du jeu est dans game.h)
+typedef struct Display {
     SDL_Window *window;
     SDL_Renderer *renderer;
-} Game;
-
-// Prototypes des fonctions principales
-void init_game(Game *game, int size, int difficulty);
-void free_game(Game *game);
-void handle_events(Game *game);
-void update_game(Game *game);
-void render_game(Game *game);
-void change_direction(Snake *snake, int new_direction);
-void move_snake(Game *game);
-void spawn_fruit(GameMap *map, int size);
-void spawn_obstacles(GameMap *map, int size, int difficulty);
-bool check_collision(Game *game);
-void show_menu(Game *game);
-void render_menu(Game *game, int selected_option);
-
-// Module Snake
-Snake create_snake(int start_x, int start_y);
-void add_segment(Snake *snake, int x, int y);
-void remove_tail(Snake *snake);
-void free_snake(Snake *snake);
+    
+    // Cache du rendu de la partie (voir render_game)
+    SDL_Texture *static_layer;    // Murs et obstacles, refait quand la map change
+    SDL_Texture *frame;           // Dernière image, mise à jour case par case
+    unsigned int static_version;  // Version de la map cuite dans static_layer
+    bool cache_valid;             // false : prochaine image entièrement redessinée
+    SDL_Rect *rects;              // Tampon des rectangles envoyés par lot
+    int rects_capacity;
+    Viewport viewport;            // Zone de la map de la dernière image dessinée
+    unsigned char *drawn;         // Couleurs des cases de cette image (comparées à l'image suivante)
+    int *dirty;                   // Cases visibles qui ont changé de couleur
+    
+    // Rendu logiciel (--software ou renderer accéléré indisponible)
+    bool software;
+    Framebuffer fb;
+    SDL_Texture *fb_texture;
+    
+    Scenes scenes;                // Scène courante, toutes pilotées par la boucle de main (scene.h)
+    Menu menu;
+    Simulation *simulation;       // Tourne seulement dans la scène de jeu
+    
+    Profiler profiler;            // Durées des phases de la boucle, affichables en jeu (F3)
+    bool autopilot;               // Serpent dirigé par l'IA : les flèches sont ignorées
+} Display;
 
-// Module GameMap
-GameMap create_map(int size);
-void free_map(GameMap *map);
-char get_cell(GameMap *map, int x, int y);
-void set_cell(GameMap *map, int x, int y, char value);
+// Prototypes de l'affichage
+bool init_display(Display *display, bool software);
+void free_display(Display *display);
+void invalidate_display(Display *display);
+void attach_scenes(Display *display, Game *game, Simulation *simulation);
+bool handle_events(Display *display, Game *game);
+void render_game(Display *display, const Snapshot *snapshot);
+MenuState menu_event(Menu *menu, const SDL_Event *event, bool *redraw);
+void draw_menu(Display *display, Menu *menu);
+void render_menu(Display *display, int selected_option);
 
-#endif
\ No newline at end of file
+#endif
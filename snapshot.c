@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snapshot.h"
+
+// cells_capacity : nombre maximal de cases visibles, (largeur / MIN_CELL_SIZE) * (hauteur / MIN_CELL_SIZE)
+bool create_triple_buffer(TripleBuffer *buffer, int cells_capacity) {
+    memset(buffer, 0, sizeof(*buffer));
+    for (int i = 0; i < 3; i++) {
+        buffer->slots[i].cells = calloc(cells_capacity, 1);
+        if (!buffer->slots[i].cells) {
+            printf("Erreur: memoire insuffisante pour les images de la partie\n");
+            free_triple_buffer(buffer);
+            return false;
+        }
+    }
+    buffer->cells_capacity = cells_capacity;
+    buffer->back = 0;
+    buffer->middle = 1;
+    buffer->front = 2;
+    return true;
+}
+
+void free_triple_buffer(TripleBuffer *buffer) {
+    for (int i = 0; i < 3; i++) {
+        free(buffer->slots[i].cells);
+        buffer->slots[i].cells = NULL;
+    }
+    buffer->cells_capacity = 0;
+}
+
+// Producteur : remplit back avec l'état courant, à compléter éventuellement avant
+// publish_snapshot. camera suit la tête comme dans update_viewport.
+Snapshot *capture_snapshot(TripleBuffer *buffer, Game *game, Viewport *camera, int width, int height) {
+    Snapshot *snapshot = &buffer->slots[buffer->back];
+    GameMap *map = &game->map;
+
+    update_viewport(camera, map, snake_head(&game->snake), width, height);
+    snapshot->viewport = *camera;
+    snapshot->ticks = game->ticks;
+    snapshot->score = game->score;
+    snapshot->running = game->running;
+    snapshot->won = game->won;
+    snapshot->game_speed = game->game_speed;
+    snapshot->static_version = map->static_version;
+
+    unsigned char *cell = snapshot->cells;
+    for (int y = 0; y < camera->rows; y++) {
+        int row_start = cell_index(map, camera->x, camera->y + y);
+        for (int x = 0; x < camera->columns; x++) {
+            *cell++ = (unsigned char)cell_color(map, row_start + x);
+        }
+    }
+    return snapshot;
+}
+
+// Producteur : rend back visible ; l'ancien middle, jamais lu ou déjà lu, devient back
+void publish_snapshot(TripleBuffer *buffer) {
+    int previous = __atomic_exchange_n(&buffer->middle, buffer->back | SNAPSHOT_FRESH, __ATOMIC_ACQ_REL);
+    buffer->back = previous & ~SNAPSHOT_FRESH;
+}
+
+// Consommateur : dernière image publiée ; fresh indique si elle est nouvelle
+// depuis l'appel précédent. L'image reste valable jusqu'au prochain appel.
+const Snapshot *latest_snapshot(TripleBuffer *buffer, bool *fresh) {
+    *fresh = __atomic_load_n(&buffer->middle, __ATOMIC_ACQUIRE) & SNAPSHOT_FRESH;
+    if (*fresh) {
+        int previous = __atomic_exchange_n(&buffer->middle, buffer->front, __ATOMIC_ACQ_REL);
+        buffer->front = previous & ~SNAPSHOT_FRESH;
+    }
+    return &buffer->slots[buffer->front];
+}
@@ -0,0 +1,44 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+#include "framebuffer.h"
+
+// Image figée de la partie, publiée par le thread de simulation après ses ticks
+// et lue par le thread d'affichage : couleur de chaque case de la zone visible
+// et les quelques valeurs affichées. Le rendu ne lit jamais Game.
+
+typedef struct Snapshot {
+    long ticks;
+    int score;
+    bool running;
+    bool won;
+    int game_speed;
+    unsigned int static_version;    // static_version de la map à la capture
+    Viewport viewport;              // Zone capturée (caméra de la simulation)
+    unsigned char *cells;           // Couleur (COLOR_*) de chaque case visible, ligne par ligne
+    uint32_t update_ns[3];          // Durée des ticks : p50, p99, max (panneau F3)
+} Snapshot;
+
+// Triple tampon sans verrou à un producteur et un consommateur : le producteur
+// remplit back puis l'échange avec middle ; le consommateur échange front avec
+// middle seulement si middle a été publié depuis sa dernière lecture.
+#define SNAPSHOT_FRESH 4    // Bit de middle : publié et pas encore lu
+
+typedef struct TripleBuffer {
+    Snapshot slots[3];
+    int cells_capacity;
+    int back;           // Producteur seulement
+    int middle;         // Index partagé (accès atomiques), avec SNAPSHOT_FRESH
+    int front;          // Consommateur seulement
+} TripleBuffer;
+
+bool create_triple_buffer(TripleBuffer *buffer, int cells_capacity);
+void free_triple_buffer(TripleBuffer *buffer);
+Snapshot *capture_snapshot(TripleBuffer *buffer, Game *game, Viewport *camera, int width, int height);
+void publish_snapshot(TripleBuffer *buffer);
+const Snapshot *latest_snapshot(TripleBuffer *buffer, bool *fresh);
+
+#endif